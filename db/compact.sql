@@ -0,0 +1,167 @@
+DROP TABLE IF EXISTS player_name_search;
+DROP TABLE IF EXISTS club_name_search;
+DROP TABLE IF EXISTS appearances_compact;
+DROP TABLE IF EXISTS games_compact;
+DROP TABLE IF EXISTS players_compact;
+DROP TABLE IF EXISTS clubs_compact;
+DROP TABLE IF EXISTS club_names;
+DROP TABLE IF EXISTS competition_codes;
+DROP TABLE IF EXISTS position_codes;
+
+CREATE TABLE position_codes (
+    position_code INTEGER PRIMARY KEY,
+    name TEXT NOT NULL UNIQUE
+) STRICT;
+
+INSERT INTO position_codes (name)
+SELECT name FROM (
+    SELECT sub_position AS name FROM players
+    UNION
+    SELECT position FROM players
+)
+WHERE name IS NOT NULL AND name <> ''
+ORDER BY name;
+
+CREATE TABLE competition_codes (
+    competition_code INTEGER PRIMARY KEY,
+    competition_id TEXT NOT NULL UNIQUE
+) STRICT;
+
+INSERT INTO competition_codes (competition_id)
+SELECT competition_id FROM (
+    SELECT competition_id FROM competitions
+    UNION
+    SELECT competition_id FROM games
+)
+WHERE competition_id IS NOT NULL
+ORDER BY competition_id;
+
+CREATE TABLE club_names (
+    club_id INTEGER PRIMARY KEY,
+    name TEXT NOT NULL
+) STRICT;
+
+INSERT INTO club_names (club_id, name)
+SELECT CAST(club_id AS INTEGER), name FROM clubs
+WHERE club_id IS NOT NULL AND name IS NOT NULL;
+
+INSERT OR IGNORE INTO club_names (club_id, name)
+SELECT CAST(current_club_id AS INTEGER), current_club_name FROM players
+WHERE current_club_id IS NOT NULL AND current_club_name IS NOT NULL;
+
+CREATE TABLE clubs_compact (
+    club_id INTEGER PRIMARY KEY,
+    last_season INTEGER,
+    domestic_competition_code INTEGER
+) STRICT;
+
+INSERT INTO clubs_compact (club_id, last_season, domestic_competition_code)
+SELECT CAST(c.club_id AS INTEGER), CAST(c.last_season AS INTEGER), cc.competition_code
+FROM clubs c
+LEFT JOIN competition_codes cc ON cc.competition_id = c.domestic_competition_id
+WHERE c.club_id IS NOT NULL;
+
+CREATE INDEX idx_clubs_compact_season ON clubs_compact(last_season);
+
+CREATE TABLE players_compact (
+    player_id INTEGER PRIMARY KEY,
+    club_id INTEGER,
+    last_season INTEGER,
+    sub_position_code INTEGER,
+    position_code INTEGER,
+    contract_expiration_day INTEGER,
+    market_value INTEGER,
+    highest_market_value INTEGER,
+    name TEXT NOT NULL,
+    image_url TEXT
+) STRICT;
+
+INSERT INTO players_compact
+SELECT
+    CAST(p.player_id AS INTEGER),
+    CAST(p.current_club_id AS INTEGER),
+    CAST(p.last_season AS INTEGER),
+    sp.position_code,
+    pp.position_code,
+    CAST(julianday(p.contract_expiration_date) - 2440587.5 AS INTEGER),
+    CAST(p.market_value_in_eur AS INTEGER),
+    CAST(p.highest_market_value_in_eur AS INTEGER),
+    COALESCE(p.name, ''),
+    p.image_url
+FROM players p
+LEFT JOIN position_codes sp ON sp.name = p.sub_position
+LEFT JOIN position_codes pp ON pp.name = p.position
+WHERE p.player_id IS NOT NULL;
+
+CREATE INDEX idx_players_compact_season_club ON players_compact(last_season, club_id);
+CREATE INDEX idx_players_compact_sub_position ON players_compact(sub_position_code);
+
+CREATE TABLE games_compact (
+    game_id INTEGER PRIMARY KEY,
+    competition_code INTEGER,
+    season INTEGER,
+    day INTEGER,
+    home_club_id INTEGER,
+    away_club_id INTEGER,
+    home_goals INTEGER,
+    away_goals INTEGER
+) STRICT;
+
+INSERT INTO games_compact
+SELECT
+    CAST(g.game_id AS INTEGER),
+    cc.competition_code,
+    CAST(g.season AS INTEGER),
+    CAST(julianday(g.date) - 2440587.5 AS INTEGER),
+    CAST(g.home_club_id AS INTEGER),
+    CAST(g.away_club_id AS INTEGER),
+    CAST(g.home_club_goals AS INTEGER),
+    CAST(g.away_club_goals AS INTEGER)
+FROM games g
+LEFT JOIN competition_codes cc ON cc.competition_id = g.competition_id
+WHERE g.game_id IS NOT NULL;
+
+CREATE INDEX idx_games_compact_day ON games_compact(day);
+CREATE INDEX idx_games_compact_home ON games_compact(home_club_id);
+CREATE INDEX idx_games_compact_away ON games_compact(away_club_id);
+
+CREATE TABLE appearances_compact (
+    player_id INTEGER NOT NULL,
+    game_id INTEGER NOT NULL,
+    club_id INTEGER,
+    goals INTEGER,
+    assists INTEGER,
+    minutes_played INTEGER,
+    PRIMARY KEY (player_id, game_id)
+) STRICT, WITHOUT ROWID;
+
+INSERT OR REPLACE INTO appearances_compact
+SELECT
+    CAST(player_id AS INTEGER),
+    CAST(game_id AS INTEGER),
+    CAST(player_club_id AS INTEGER),
+    CAST(goals AS INTEGER),
+    CAST(assists AS INTEGER),
+    CAST(minutes_played AS INTEGER)
+FROM appearances
+WHERE player_id IS NOT NULL AND game_id IS NOT NULL;
+
+CREATE INDEX idx_appearances_compact_game ON appearances_compact(game_id);
+
+CREATE VIRTUAL TABLE player_name_search USING fts5(
+    name,
+    content='players_compact',
+    content_rowid='player_id',
+    tokenize='trigram'
+);
+
+INSERT INTO player_name_search (player_name_search) VALUES ('rebuild');
+
+CREATE VIRTUAL TABLE club_name_search USING fts5(
+    name,
+    content='club_names',
+    content_rowid='club_id',
+    tokenize='trigram'
+);
+
+INSERT INTO club_name_search (club_name_search) VALUES ('rebuild');
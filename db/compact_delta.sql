@@ -0,0 +1,137 @@
+-- Brings the tables of compact.sql up to date after a dataset patch, touching only
+-- the rows derived from what changed. Runs in the patch transaction once the raw
+-- rows are replaced: temp.previous_<table> holds the replaced and deleted rows,
+-- patch.<table> the new ones.
+
+CREATE TEMP TABLE affected_players AS
+SELECT CAST(player_id AS INTEGER) AS player_id FROM temp.previous_players
+UNION
+SELECT CAST(player_id AS INTEGER) FROM patch.players;
+
+CREATE TEMP TABLE affected_clubs AS
+SELECT CAST(club_id AS INTEGER) AS club_id FROM temp.previous_clubs
+UNION
+SELECT CAST(club_id AS INTEGER) FROM patch.clubs
+UNION
+SELECT CAST(current_club_id AS INTEGER) FROM temp.previous_players
+UNION
+SELECT CAST(current_club_id AS INTEGER) FROM patch.players;
+
+CREATE TEMP TABLE affected_games AS
+SELECT CAST(game_id AS INTEGER) AS game_id FROM temp.previous_games
+UNION
+SELECT CAST(game_id AS INTEGER) FROM patch.games;
+
+CREATE TEMP TABLE affected_appearances AS
+SELECT CAST(player_id AS INTEGER) AS player_id, CAST(game_id AS INTEGER) AS game_id FROM temp.previous_appearances
+UNION
+SELECT CAST(player_id AS INTEGER), CAST(game_id AS INTEGER) FROM patch.appearances;
+
+-- Existing codes keep their value, new names are appended.
+INSERT OR IGNORE INTO position_codes (name)
+SELECT name FROM (
+    SELECT sub_position AS name FROM patch.players
+    UNION
+    SELECT position FROM patch.players
+)
+WHERE name IS NOT NULL AND name <> ''
+ORDER BY name;
+
+INSERT OR IGNORE INTO competition_codes (competition_id)
+SELECT competition_id FROM (
+    SELECT competition_id FROM patch.competitions
+    UNION
+    SELECT competition_id FROM patch.games
+)
+WHERE competition_id IS NOT NULL
+ORDER BY competition_id;
+
+-- External content indexes drop an entry by the values it was indexed with, so
+-- these run while the compact rows still hold them.
+INSERT INTO player_name_search (player_name_search, rowid, name)
+SELECT 'delete', player_id, name FROM players_compact
+WHERE player_id IN (SELECT player_id FROM affected_players);
+
+INSERT INTO club_name_search (club_name_search, rowid, name)
+SELECT 'delete', club_id, name FROM club_names
+WHERE club_id IN (SELECT club_id FROM affected_clubs);
+
+DELETE FROM club_names WHERE club_id IN (SELECT club_id FROM affected_clubs);
+
+INSERT INTO club_names (club_id, name)
+SELECT CAST(club_id AS INTEGER), name FROM clubs
+WHERE club_id IN (SELECT club_id FROM affected_clubs) AND name IS NOT NULL;
+
+INSERT OR IGNORE INTO club_names (club_id, name)
+SELECT CAST(current_club_id AS INTEGER), current_club_name FROM players
+WHERE current_club_id IN (SELECT club_id FROM affected_clubs) AND current_club_name IS NOT NULL;
+
+DELETE FROM clubs_compact WHERE club_id IN (SELECT club_id FROM affected_clubs);
+
+INSERT INTO clubs_compact (club_id, last_season, domestic_competition_code)
+SELECT CAST(c.club_id AS INTEGER), CAST(c.last_season AS INTEGER), cc.competition_code
+FROM clubs c
+LEFT JOIN competition_codes cc ON cc.competition_id = c.domestic_competition_id
+WHERE c.club_id IN (SELECT club_id FROM affected_clubs);
+
+DELETE FROM players_compact WHERE player_id IN (SELECT player_id FROM affected_players);
+
+INSERT INTO players_compact
+SELECT
+    CAST(p.player_id AS INTEGER),
+    CAST(p.current_club_id AS INTEGER),
+    CAST(p.last_season AS INTEGER),
+    sp.position_code,
+    pp.position_code,
+    CAST(julianday(p.contract_expiration_date) - 2440587.5 AS INTEGER),
+    CAST(p.market_value_in_eur AS INTEGER),
+    CAST(p.highest_market_value_in_eur AS INTEGER),
+    COALESCE(p.name, ''),
+    p.image_url
+FROM players p
+LEFT JOIN position_codes sp ON sp.name = p.sub_position
+LEFT JOIN position_codes pp ON pp.name = p.position
+WHERE p.player_id IN (SELECT player_id FROM affected_players);
+
+DELETE FROM games_compact WHERE game_id IN (SELECT game_id FROM affected_games);
+
+INSERT INTO games_compact
+SELECT
+    CAST(g.game_id AS INTEGER),
+    cc.competition_code,
+    CAST(g.season AS INTEGER),
+    CAST(julianday(g.date) - 2440587.5 AS INTEGER),
+    CAST(g.home_club_id AS INTEGER),
+    CAST(g.away_club_id AS INTEGER),
+    CAST(g.home_club_goals AS INTEGER),
+    CAST(g.away_club_goals AS INTEGER)
+FROM games g
+LEFT JOIN competition_codes cc ON cc.competition_id = g.competition_id
+WHERE g.game_id IN (SELECT game_id FROM affected_games);
+
+DELETE FROM appearances_compact
+WHERE (player_id, game_id) IN (SELECT player_id, game_id FROM affected_appearances);
+
+INSERT OR REPLACE INTO appearances_compact
+SELECT
+    CAST(a.player_id AS INTEGER),
+    CAST(a.game_id AS INTEGER),
+    CAST(a.player_club_id AS INTEGER),
+    CAST(a.goals AS INTEGER),
+    CAST(a.assists AS INTEGER),
+    CAST(a.minutes_played AS INTEGER)
+FROM affected_appearances x
+JOIN appearances a ON a.player_id = x.player_id AND a.game_id = x.game_id;
+
+INSERT INTO player_name_search (rowid, name)
+SELECT player_id, name FROM players_compact
+WHERE player_id IN (SELECT player_id FROM affected_players);
+
+INSERT INTO club_name_search (rowid, name)
+SELECT club_id, name FROM club_names
+WHERE club_id IN (SELECT club_id FROM affected_clubs);
+
+DROP TABLE temp.affected_players;
+DROP TABLE temp.affected_clubs;
+DROP TABLE temp.affected_games;
+DROP TABLE temp.affected_appearances;
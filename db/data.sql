@@ -174,3 +174,11 @@ CREATE TABLE IF NOT EXISTS transfers (
     player_name TEXT,
     UNIQUE(player_id, transfer_date, to_club_name)
 );
+
+CREATE TABLE IF NOT EXISTS dataset_row_hashes (
+    table_name TEXT NOT NULL,
+    key_hash INTEGER NOT NULL,
+    row_key TEXT NOT NULL,
+    row_hash INTEGER NOT NULL,
+    PRIMARY KEY (table_name, key_hash)
+) WITHOUT ROWID;
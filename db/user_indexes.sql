@@ -0,0 +1 @@
+CREATE INDEX IF NOT EXISTS idx_team_lineups_team ON team_lineups (team_id, is_active);
@@ -9,6 +9,7 @@
 class RatingManager;
 class TeamManager;
 class Database;
+class DatasetPatch;
 
 class DataLoader final : public QObject {
     Q_OBJECT
@@ -18,19 +19,27 @@ class DataLoader final : public QObject {
                         TeamManager& teamManager, 
                         Database& database, 
                         QObject* parent = nullptr);
-        ~DataLoader() override = default;
+        ~DataLoader() override;
 
         DataLoader(const DataLoader&) = delete;
         DataLoader& operator=(const DataLoader&) = delete;
         DataLoader(DataLoader&&) = delete;
         DataLoader& operator=(DataLoader&&) = delete;
 
+        [[nodiscard]] bool hasDatasetUpdate() const noexcept { return m_pendingUpdate != nullptr; }
+        // Writes the update prepared by prepareDatasetUpdate into the dataset and
+        // reloads ratings and teams if it changed anything. Runs on the thread
+        // that owns the views.
+        void applyDatasetUpdate();
+
     public slots:
         void loadData();
+        void prepareDatasetUpdate();
         
     signals:
         void progressUpdate(const QString& status, int progress);
         void loadingComplete();
+        void datasetUpdatePrepared();
             
     private:
         void initializeDatabase();
@@ -41,6 +50,7 @@ class DataLoader final : public QObject {
         RatingManager& m_ratingManager;
         TeamManager& m_teamManager;
         Database& m_database;
+        std::unique_ptr<DatasetPatch> m_pendingUpdate;
 };
 
 #endif
@@ -5,6 +5,7 @@
 #include <QTableView>
 #include <QLineEdit>
 #include <QPushButton>
+#include "utils/database/NameSearch.h"
 #include <vector>
 #include <string>
 #include <span>
@@ -16,7 +17,9 @@ class ClubSelectDialog : public QDialog {
     Q_OBJECT
 
     public:
-        explicit ClubSelectDialog(std::span<const std::pair<int, std::string>> clubs, QWidget* parent = nullptr);
+        explicit ClubSelectDialog(std::span<const std::pair<int, std::string>> clubs, 
+                                  NameSearchFunction clubSearch = {},
+                                  QWidget* parent = nullptr);
         ~ClubSelectDialog() override = default;
         
         [[nodiscard]] std::optional<int> getSelectedClubId() const;
@@ -42,6 +45,7 @@ class ClubSelectDialog : public QDialog {
         
         std::vector<std::pair<int, std::string>> m_availableClubs;
         std::optional<int> m_selectedClubId;
+        NameSearchFunction m_clubSearch;
 };
 
 #endif
@@ -9,6 +9,7 @@
 #include <string>
 #include <span>
 #include <optional>
+#include <unordered_set>
 
 class PlayerListModel final : public QAbstractTableModel {
     Q_OBJECT
@@ -30,6 +31,7 @@ class PlayerListModel final : public QAbstractTableModel {
         void setPagination(int start, int max);
         [[nodiscard]] size_t totalPlayers() const noexcept;
         [[nodiscard]] int filteredPlayerCount() const noexcept;
+        void setNameSearch(NameSearchFunction search) { m_nameSearch = std::move(search); }
 
     public slots:
         void setFilter(const QString& filter);
@@ -38,6 +40,7 @@ class PlayerListModel final : public QAbstractTableModel {
 
     private:
         void applyFilters();
+        void refreshNameMatches();
         [[nodiscard]] QVariant getDisplayData(const QModelIndex& index) const;
         [[nodiscard]] bool matchesFilter(const std::pair<int, Player>& player) const;
         [[nodiscard]] bool matchesPosition(const std::pair<int, Player>& player) const;
@@ -48,6 +51,8 @@ class PlayerListModel final : public QAbstractTableModel {
         std::vector<std::pair<int, Player>> m_filteredPlayers;
         QString m_currentFilter;
         QString m_currentPosition;
+        NameSearchFunction m_nameSearch;
+        std::optional<std::unordered_set<int>> m_nameMatches;
 };
 
 #endif
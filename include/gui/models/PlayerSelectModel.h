@@ -32,6 +32,7 @@ class PlayerSelectModel final : public QAbstractTableModel {
         void setPositionFilter(const QString& position);
         void setPagination(int start, int max);
         [[nodiscard]] int filteredPlayerCount() const noexcept;
+        void setNameSearch(NameSearchFunction search) { m_nameSearch = std::move(search); }
         
         void togglePlayerSelection(const QModelIndex& index);
         void selectPlayer(int playerId);
@@ -44,6 +45,7 @@ class PlayerSelectModel final : public QAbstractTableModel {
 
     private:
         void applyFilters();
+        void refreshNameMatches();
         void updatePlayerVisibility(int playerId);
         
         [[nodiscard]] QVariant getDisplayData(const QModelIndex& index) const;
@@ -62,6 +64,8 @@ class PlayerSelectModel final : public QAbstractTableModel {
         
         QString m_currentFilter;
         QString m_currentPosition;
+        NameSearchFunction m_nameSearch;
+        std::optional<std::unordered_set<int>> m_nameMatches;
         int m_startIndex = 0;
         int m_maxPlayers = 20;
 };
@@ -23,7 +23,8 @@ class LoadingView final : public QWidget {
         LoadingView& operator=(LoadingView&&) = delete;
 
     public slots:
-        void updateStatus(const QString& status);
+        // Text after the first line break is shown as a detail line below the status.
+        void updateStatus(const QString& text);
         void updateProgress(int value);
         void markLoadingComplete();
             
@@ -42,6 +43,8 @@ class LoadingView final : public QWidget {
         void setupAppNameAnimation();
         
         QLabel* m_statusLabel{nullptr};
+        QLabel* m_detailLabel{nullptr};
+        QString m_currentStatus;
         QLabel* m_appNameLabel{nullptr};
         QProgressBar* m_progressBar{nullptr};
         
@@ -23,7 +23,7 @@ class MainWindow final : public QMainWindow {
 
     public:
         explicit MainWindow(RatingManager& ratingManager, TeamManager& teamManager, Database& database, QWidget* parent = nullptr);
-        ~MainWindow() override = default;
+        ~MainWindow() override;
         
         MainWindow(const MainWindow&) = delete;
         MainWindow& operator=(const MainWindow&) = delete;
@@ -41,6 +41,7 @@ class MainWindow final : public QMainWindow {
         void initializeApplication();
         void handleDataLoadProgress(const QString& status, int progress);
         void transitionToMainView();
+        void applyDatasetUpdate();
 
     private:
         void setupUserInterface();
@@ -64,10 +65,12 @@ class MainWindow final : public QMainWindow {
         QStackedWidget* m_stackedWidget{nullptr};
         
         std::unique_ptr<QThread> m_loadingThread;
+        DataLoader* m_dataLoader{nullptr};
         std::unique_ptr<QGraphicsOpacityEffect> m_viewTransitionEffect;
         std::unique_ptr<QPropertyAnimation> m_fadeAnimation;
 
         bool m_appInitialized{false};
+        bool m_datasetUpdatePending{false};
 };
 
 #endif
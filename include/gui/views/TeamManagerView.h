@@ -14,10 +14,13 @@
 #include <QGraphicsOpacityEffect>
 #include <QPropertyAnimation>
 #include <QParallelAnimationGroup>
+#include <QProgressDialog>
+#include <QFutureWatcher>
 #include <memory>
 #include <optional>
 #include <span>
 #include <unordered_map>
+#include <stop_token>
 #include "services/TeamManager.h"
 #include "gui/models/TeamListModel.h"
 #include "gui/views/LineupView.h"
@@ -41,6 +44,7 @@ class TeamManagerView final : public QWidget {
         void createNewTeam();
         void loadSelectedTeam();
         void autoFillTeam();
+        void cancelAutoFill();
         void updateTeamInfo();
         void showClubSelectionDialog();
         void updateBudget(int newBudget);
@@ -155,6 +159,18 @@ class TeamManagerView final : public QWidget {
         void resetComparisonState();
         void fadeOutPlayerDetails();
         
+        void startAutoFill(std::vector<std::string> missingPositions, int64_t budget);
+        void updateAutoFillProgress(const SelectionProgress& progress);
+        void finishAutoFill(int teamId);
+        void applyAutoFillResult(int teamId, const SelectionResult& result);
+        void reportAutoFillError(const std::exception& e);
+        void refreshAutoFillPreview();
+        void showPreviewBound(int teamId, int64_t budget, const SelectionPreview& preview);
+        void startExactPreviewSolve();
+        void finishExactPreviewSolve(int teamId, int64_t budget);
+        [[nodiscard]] QString describeAutoFillTeam(std::span<const std::pair<int, Player>> team) const;
+        [[nodiscard]] QString describeAutoFillResult(const SelectionResult& result) const;
+        
         void updateTeamRatingDisplay();
         void updateTeamRatingLabel(double averageRating, double ratingDiff);
 
@@ -193,6 +209,7 @@ class TeamManagerView final : public QWidget {
 
         QLineEdit* m_teamNameInput{nullptr};
         QSpinBox* m_budgetInput{nullptr};
+        QLabel* m_autoFillPreviewLabel{nullptr};
 
         QLabel* m_playerImage{nullptr};
         QLabel* m_playerName{nullptr};
@@ -203,6 +220,24 @@ class TeamManagerView final : public QWidget {
         QLabel* m_teamRatingLabel{nullptr};
         QWidget* m_teamRatingWidget{nullptr};
 
+        static constexpr int AUTO_FILL_TIME_LIMIT_MS = 5000;
+        
+        std::stop_source m_autoFillStopSource;
+        QFutureWatcher<SelectionResult>* m_autoFillWatcher{nullptr};
+        QProgressDialog* m_autoFillProgress{nullptr};
+
+        struct ExactAutoFill {
+            int teamId;
+            int64_t budget;
+            SelectionResult result;
+        };
+
+        std::vector<std::string> m_previewMissingPositions;
+        std::stop_source m_previewStopSource;
+        QFutureWatcher<SelectionResult>* m_previewWatcher{nullptr};
+        bool m_previewPending{false};
+        std::optional<ExactAutoFill> m_exactAutoFill;
+
         std::vector<std::pair<int, std::string>> m_availableClubs;
         std::unordered_map<int, double> m_teamInitialRatings;
         double m_initialTeamRating{0.0};
@@ -2,20 +2,108 @@
 #define ILP_SELECTOR_H
 
 #include "models/PlayerRating.h"
+#include "models/SquadRequirements.h"
 #include <vector>
 #include <string>
 #include <string_view>
 #include <span>
 #include <glpk.h>
 #include <cstdint>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <stop_token>
+#include <mutex>
+
+enum class SelectionStatus {
+    Optimal,
+    TimeLimit,
+    Cancelled,
+    Infeasible,
+    Failed
+};
+
+struct SelectionProgress {
+    double incumbentObjective{0.0};
+    double bestBound{0.0};
+    double gap{0.0};
+    std::chrono::milliseconds elapsed{0};
+};
+
+struct SelectionOptions {
+    static constexpr int DEFAULT_TIME_LIMIT_MS = 10000;
+
+    int timeLimitMs{DEFAULT_TIME_LIMIT_MS};
+    std::function<void(const SelectionProgress&)> onProgress;
+    std::stop_token stopToken;
+};
+
+struct SelectionResult {
+    std::vector<std::pair<int, Player>> team;
+    SelectionStatus status{SelectionStatus::Infeasible};
+    double objective{0.0};
+    double gap{std::numeric_limits<double>::infinity()};
+    std::chrono::milliseconds elapsed{0};
+};
+
+struct SelectionPreview {
+    std::vector<std::pair<int, Player>> team;
+    double objective{0.0};
+    double bound{std::numeric_limits<double>::infinity()};
+    double gap{std::numeric_limits<double>::infinity()};
+    std::chrono::microseconds elapsed{0};
+};
+
+// The LP bound takes the GLPK environment, which a non-thread-local build
+// shares with any solve running in the background.
+enum class PreviewBound {
+    Skip,
+    Relaxation
+};
+
+enum class RobustCriterion {
+    Expected,
+    WorstDecile
+};
+
+struct RobustOptions {
+    static constexpr int DEFAULT_SCENARIO_COUNT = 500;
+    static constexpr int DEFAULT_SCENARIO_TIME_LIMIT_MS = 1000;
+
+    int scenarioCount{DEFAULT_SCENARIO_COUNT};
+    RobustCriterion criterion{RobustCriterion::Expected};
+    uint64_t seed{0};
+    int scenarioTimeLimitMs{DEFAULT_SCENARIO_TIME_LIMIT_MS};
+    std::stop_token stopToken;
+};
+
+struct RobustSelectionResult {
+    SelectionResult selection;
+    double expectedRating{0.0};
+    double worstDecileRating{0.0};
+    int scenariosSolved{0};
+    int distinctTeams{0};
+};
 
 class ILPSelector {
     public:
-        ILPSelector(std::span<const std::pair<int, Player>> players, 
+        ILPSelector(std::span<const std::pair<int, Player>> players,
                     std::span<const std::string> requiredPositions,
                     int64_t budget);
 
+        ILPSelector(std::span<const std::pair<int, Player>> players,
+                    SquadRequirements requirements,
+                    int64_t budget);
+
         [[nodiscard]] std::vector<std::pair<int, Player>> selectTeam() const;
+        [[nodiscard]] SelectionResult solve(const SelectionOptions& options) const;
+        [[nodiscard]] SelectionPreview preview(PreviewBound bound = PreviewBound::Relaxation) const;
+        [[nodiscard]] RobustSelectionResult solveRobust(std::span<const double> ratingDeviations,
+                                                        const RobustOptions& options) const;
+
+        [[nodiscard]] static std::vector<std::pair<int, Player>> pruneCandidates(
+            std::span<const std::pair<int, Player>> players,
+            const SquadRequirements& requirements);
 
     private:
         struct Variable {
@@ -23,22 +111,57 @@ class ILPSelector {
             size_t positionIdx;
             int varIdx;
             double rating;
+            double coefficient;
+            double deviation;
             int64_t cost;
         };
 
+        struct ConstraintMatrix {
+            std::vector<int> rows{0};
+            std::vector<int> cols{0};
+            std::vector<double> values{0.0};
+
+            void add(int row, int col, double value);
+            [[nodiscard]] int size() const noexcept { return static_cast<int>(rows.size()) - 1; }
+        };
+
+        struct SolverContext {
+            const SelectionOptions* options;
+            std::chrono::steady_clock::time_point startTime;
+            double bestBound{std::numeric_limits<double>::infinity()};
+        };
+
         std::span<const std::pair<int, Player>> m_players;
-        std::span<const std::string> m_requiredPositions;
+        SquadRequirements m_requirements;
         int64_t m_budget;
 
-        [[nodiscard]] std::vector<Variable> createVariables() const;
-        void addBudgetConstraint(glp_prob* lp, std::span<const Variable> vars) const;
-        void addPositionConstraints(glp_prob* lp, std::span<const Variable> vars) const;
+        static constexpr double ROBUST_PRUNE_DEVIATIONS = 3.0;
+
+        [[nodiscard]] std::vector<Variable> createVariables(std::span<const double> ratingDeviations = {}) const;
+        [[nodiscard]] std::vector<Variable> pruneDominatedVariables(std::vector<Variable> vars, double deviationMargin) const;
+        [[nodiscard]] std::vector<size_t> greedySelection(std::span<const Variable> vars) const;
+        [[nodiscard]] double relaxationBound(std::span<const Variable> vars) const;
+        [[nodiscard]] std::vector<std::vector<double>> sampleScenarios(std::span<const Variable> vars,
+                                                                      const RobustOptions& options) const;
+        [[nodiscard]] std::vector<std::vector<int>> solveScenarios(std::span<const Variable> vars,
+                                                                   std::span<const std::vector<double>> scenarios,
+                                                                   const RobustOptions& options) const;
+        void assignObjectiveCoefficients(std::span<Variable> vars) const;
+        void addBudgetConstraint(glp_prob* lp, std::span<const Variable> vars, ConstraintMatrix& matrix) const;
+        void addPositionConstraints(glp_prob* lp, std::span<const Variable> vars, ConstraintMatrix& matrix) const;
+        void addSquadSizeConstraint(glp_prob* lp, std::span<const Variable> vars, ConstraintMatrix& matrix) const;
         void setupObjectiveFunction(glp_prob* lp, std::span<const Variable> vars) const;
         [[nodiscard]] glp_prob* createProblem() const;
+        [[nodiscard]] glp_prob* buildProblem(std::span<const Variable> vars) const;
         void configureVariables(glp_prob* lp, std::span<const Variable> vars) const;
         [[nodiscard]] std::vector<std::pair<int, Player>> extractSolution(
-            glp_prob* lp, 
+            glp_prob* lp,
             std::span<const Variable> vars) const;
+
+        static void solverCallback(glp_tree* tree, void* info);
+        [[nodiscard]] static double relativeGap(double objective, double bound);
+        [[nodiscard]] static bool hasThreadLocalEnvironment();
+        [[nodiscard]] static std::unique_lock<std::mutex> lockSolverEnvironment();
 };
 
 #endif
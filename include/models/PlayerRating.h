@@ -4,6 +4,7 @@
 #include "utils/database/repositories/GameRepository.h"
 #include "utils/database/repositories/AppearanceRepository.h"
 #include "utils/database/repositories/PlayerRepository.h"
+#include "utils/database/ReplayCache.h"
 #include <unordered_map>
 #include <vector>
 #include <string>
@@ -42,9 +43,12 @@ public:
     void initializePlayer(const Player& player);
     void processMatches(std::span<const Game> games, std::span<const PlayerAppearance> appearances);
     void processMatchesParallel(const std::vector<Game>& games, const std::vector<PlayerAppearance>& appearances);
+    void processReplay(const ReplayColumns& replay);
     
     [[nodiscard]] std::vector<RatingChange> getPlayerRatingHistory(int playerId, int maxGames = 10) const;
     [[nodiscard]] std::vector<std::pair<int, Player>> getSortedRatedPlayers() const;
+    [[nodiscard]] double getRatingDeviation(int playerId) const;
+    [[nodiscard]] const Player* findRatedPlayer(int playerId) const;
     
     static bool sortPlayersByRating(const std::pair<int, Player>& a, const std::pair<int, Player>& b);
     
@@ -52,6 +56,7 @@ private:
     using PlayerId = int;
     
     static constexpr int MAX_HISTORY_SIZE = 10;
+    static constexpr double MIN_RATING_DEVIATION = 10.0;
     
     double kFactor;
     double homeAdvantage;
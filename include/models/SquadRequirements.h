@@ -0,0 +1,36 @@
+#ifndef SQUAD_REQUIREMENTS_H
+#define SQUAD_REQUIREMENTS_H
+
+#include "utils/database/repositories/PlayerRepository.h"
+#include "models/LineupTypes.h"
+#include <vector>
+#include <string>
+#include <string_view>
+#include <span>
+#include <unordered_set>
+#include <optional>
+
+struct PositionQuota {
+    std::string subPosition;
+    int minCount{0};
+    int maxCount{0};
+};
+
+struct SquadRequirements {
+    static constexpr int STARTING_PLAYERS = 11;
+    static constexpr int MIN_SQUAD_SIZE = 18;
+    static constexpr int MAX_SQUAD_SIZE = 25;
+
+    std::vector<PositionQuota> quotas;
+    std::optional<int> squadSize;
+    std::unordered_set<int> excludedPlayerIds;
+
+    [[nodiscard]] static SquadRequirements fromPositions(std::span<const std::string> positions);
+    [[nodiscard]] static SquadRequirements fromFormation(const Formation& formation,
+                                                         int benchSize = 7,
+                                                         int reserveSize = 5);
+
+    void subtractExisting(std::span<const Player> players);
+};
+
+#endif
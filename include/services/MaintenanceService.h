@@ -0,0 +1,83 @@
+#ifndef MAINTENANCESERVICE_H
+#define MAINTENANCESERVICE_H
+
+#include <sqlite3.h>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <cstdint>
+
+class Database;
+
+struct MaintenanceReport {
+    bool backedUp{false};
+    int64_t reclaimedBytes{0};
+    int64_t fileSizeBefore{0};
+    int64_t fileSizeAfter{0};
+    std::chrono::microseconds probeLatencyBefore{0};
+    std::chrono::microseconds probeLatencyAfter{0};
+    std::chrono::milliseconds elapsed{0};
+};
+
+// Backs up and compacts the user database on its own connection once the
+// application has stopped writing to it for a while.
+class MaintenanceService {
+public:
+    static constexpr auto STARTUP_DELAY = std::chrono::minutes(2);
+    static constexpr auto IDLE_DELAY = std::chrono::seconds(30);
+    static constexpr auto POLL_INTERVAL = std::chrono::seconds(5);
+    static constexpr auto MAINTENANCE_INTERVAL = std::chrono::hours(24);
+    static constexpr auto STEP_PAUSE = std::chrono::milliseconds(20);
+    static constexpr int BACKUP_PAGES_PER_STEP = 64;
+    static constexpr int VACUUM_PAGES_PER_STEP = 256;
+    static constexpr int ANALYSIS_LIMIT = 1000;
+    static constexpr int PROBE_ITERATIONS = 20;
+    static constexpr int BUSY_TIMEOUT_MS = 2000;
+
+    explicit MaintenanceService(Database& database);
+    ~MaintenanceService();
+
+    MaintenanceService(const MaintenanceService&) = delete;
+    MaintenanceService& operator=(const MaintenanceService&) = delete;
+    MaintenanceService(MaintenanceService&&) = delete;
+    MaintenanceService& operator=(MaintenanceService&&) = delete;
+
+    void start();
+    void stop();
+
+    [[nodiscard]] std::filesystem::path backupPath() const;
+    [[nodiscard]] std::optional<MaintenanceReport> lastReport() const;
+
+    // Runs a full maintenance pass on the calling thread.
+    MaintenanceReport runNow();
+
+private:
+    std::filesystem::path m_dbPath;
+    sqlite3* m_db{nullptr};
+    std::thread m_worker;
+    std::mutex m_passMutex;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    bool m_stopping{false};
+    std::optional<MaintenanceReport> m_lastReport;
+
+    void run();
+    [[nodiscard]] bool waitFor(std::chrono::steady_clock::duration duration);
+    [[nodiscard]] bool stopRequested() const;
+    [[nodiscard]] bool isDue() const;
+    [[nodiscard]] int64_t dataVersion() const;
+
+    [[nodiscard]] bool backup();
+    [[nodiscard]] bool enableIncrementalVacuum();
+    void incrementalVacuum();
+    void analyze();
+    [[nodiscard]] std::chrono::microseconds probeLatency() const;
+    [[nodiscard]] int64_t pragmaValue(const char* pragma) const;
+    bool execute(const char* sql) const;
+};
+
+#endif
@@ -2,6 +2,8 @@
 #define RATINGMANAGER_H
 
 #include "models/PlayerRating.h"
+#include "models/SquadRequirements.h"
+#include "models/ILPSelector.h"
 #include <vector>
 #include <memory>
 #include <span>
@@ -31,6 +33,29 @@ public:
     selectOptimalTeamByPositions(
         std::span<const std::string> requiredPositions,
         int64_t budget) const;
+
+    [[nodiscard]] SelectionResult 
+    selectOptimalTeamByPositions(
+        std::span<const std::string> requiredPositions,
+        int64_t budget,
+        const SelectionOptions& options) const;
+
+    [[nodiscard]] SelectionPreview 
+    previewTeamByPositions(
+        std::span<const std::string> requiredPositions,
+        int64_t budget,
+        PreviewBound bound = PreviewBound::Relaxation) const;
+
+    [[nodiscard]] RobustSelectionResult 
+    selectRobustTeamByPositions(
+        std::span<const std::string> requiredPositions,
+        int64_t budget,
+        const RobustOptions& options) const;
+
+    [[nodiscard]] std::vector<std::pair<int, Player>> 
+    selectOptimalSquad(
+        const SquadRequirements& requirements,
+        int64_t budget) const;
     
     [[nodiscard]] std::vector<Player> 
     getFilteredRatedPlayers(std::span<const Player> filterPlayers) const;
@@ -46,12 +71,16 @@ public:
     [[nodiscard]] std::vector<std::pair<int, Player>> 
     getSortedRatedPlayers() const;
 
+    [[nodiscard]] std::span<const std::pair<int, Player>> 
+    getAutoFillCandidates() const noexcept { return m_autoFillCandidates; }
+
 private:
     Database& m_database;
     std::unique_ptr<PlayerRating> m_ratingSystem;
     std::unique_ptr<GameRepository> m_gameRepository;
     std::unique_ptr<AppearanceRepository> m_appearanceRepository;
     std::unique_ptr<PlayerRepository> m_playerRepository;
+    std::vector<std::pair<int, Player>> m_autoFillCandidates;
     
     [[nodiscard]] std::unique_ptr<GameRepository> createGameRepository() const;
     [[nodiscard]] std::unique_ptr<AppearanceRepository> createAppearanceRepository() const;
@@ -59,6 +88,7 @@ private:
     
     void initializePlayerRatings();
     void processMatchData();
+    void buildAutoFillCandidates();
 };
 
 #endif
@@ -4,7 +4,9 @@
 #include "utils/database/repositories/TeamRepository.h"
 #include "services/RatingManager.h"
 #include "utils/database/repositories/PlayerRepository.h"
-#include "gui/models/LineupTypes.h"
+#include "utils/database/repositories/ClubRepository.h"
+#include "utils/database/NameSearch.h"
+#include "models/LineupTypes.h"
 
 #include <vector>
 #include <string>
@@ -13,10 +15,21 @@
 #include <unordered_map>
 #include <string_view>
 #include <cstdint>
+#include <chrono>
+
+struct AutoFillOutcome {
+    int teamId{0};
+    std::vector<Player> addedPlayers;
+    SelectionStatus status{SelectionStatus::Infeasible};
+    double gap{0.0};
+    std::chrono::milliseconds elapsed{0};
+    std::string error;
+};
 
 class TeamManager {
 public:
-    TeamManager(TeamRepository& teamRepo, RatingManager& ratingManager, PlayerRepository& playerRepo);
+    TeamManager(TeamRepository& teamRepo, RatingManager& ratingManager, PlayerRepository& playerRepo,
+                ClubRepository& clubRepo);
     
     [[nodiscard]] std::vector<std::string> getAvailableSubPositions() const;
     [[nodiscard]] Team& loadTeamFromClub(int clubId);
@@ -30,11 +43,23 @@ public:
     
     [[nodiscard]] std::vector<std::string> getMissingPositions(const Team& team) const;
     void autoFillTeam(Team& team, int64_t budget);
+    [[nodiscard]] SelectionResult planAutoFill(std::span<const std::string> missingPositions, 
+                                               int64_t budget, 
+                                               const SelectionOptions& options) const;
+    [[nodiscard]] SelectionPreview previewAutoFill(std::span<const std::string> missingPositions, 
+                                                   int64_t budget,
+                                                   PreviewBound bound = PreviewBound::Relaxation) const;
+    void applyAutoFill(Team& team, const SelectionResult& result);
+    [[nodiscard]] std::vector<AutoFillOutcome> autoFillTeams(std::span<const int> teamIds, 
+                                                             const SelectionOptions& options = {});
+    void autoFillSquad(Team& team, const Formation& formation, int64_t budget, int benchSize = 7, int reserveSize = 5);
     void setTeamBudget(int teamId, int64_t newBudget);
     
     [[nodiscard]] std::vector<Team> getAllTeams() const;
     [[nodiscard]] Player searchPlayerById(int playerId) const;
     [[nodiscard]] std::vector<std::pair<int, std::string>> getAllClubs() const;
+    [[nodiscard]] std::vector<int> searchPlayerIds(std::string_view text) const;
+    [[nodiscard]] std::vector<int> searchClubIds(std::string_view text) const;
 
     void saveTeam(const Team& team);
     void loadTeams();
@@ -55,6 +80,7 @@ private:
     TeamRepository& m_teamRepo;
     RatingManager& m_ratingManager;
     PlayerRepository& m_playerRepo;
+    ClubRepository& m_clubRepo;
     std::unordered_map<int, Team> m_teams;
     int m_nextTeamId = 0;
 
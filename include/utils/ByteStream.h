@@ -0,0 +1,38 @@
+#ifndef BYTESTREAM_H
+#define BYTESTREAM_H
+
+#include "utils/BoundedQueue.h"
+#include <string>
+#include <string_view>
+#include <span>
+#include <atomic>
+#include <cstddef>
+
+class ByteStream {
+public:
+    static constexpr size_t DEFAULT_CAPACITY_CHUNKS = 16;
+
+    explicit ByteStream(size_t capacityChunks = DEFAULT_CAPACITY_CHUNKS);
+
+    ByteStream(const ByteStream&) = delete;
+    ByteStream& operator=(const ByteStream&) = delete;
+
+    bool write(std::string_view bytes);
+    void finish(bool success);
+    void cancel();
+
+    [[nodiscard]] size_t read(std::span<char> buffer);
+    [[nodiscard]] bool failed() const noexcept { return m_failed; }
+    [[nodiscard]] bool finished() const noexcept { return m_finished; }
+    [[nodiscard]] bool cancelled() const noexcept { return m_cancelled; }
+
+private:
+    BoundedQueue<std::string> m_chunks;
+    std::string m_current;
+    size_t m_offset{0};
+    bool m_finished{false};
+    std::atomic<bool> m_failed{false};
+    std::atomic<bool> m_cancelled{false};
+};
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef DAYDATE_H
+#define DAYDATE_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+using DayNumber = int32_t;
+
+// Days since 1970-01-01, as stored in the compact dataset tables. 0 marks an unknown date.
+inline std::string formatDayNumber(DayNumber day) {
+    if (day == 0) {
+        return {};
+    }
+
+    const std::chrono::year_month_day date{std::chrono::sys_days{std::chrono::days{day}}};
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u",
+                  static_cast<int>(date.year()),
+                  static_cast<unsigned>(date.month()),
+                  static_cast<unsigned>(date.day()));
+    return buffer;
+}
+
+#endif
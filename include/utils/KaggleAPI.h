@@ -10,8 +10,17 @@
 #include <vector>
 #include <memory>
 
+class ByteStream;
+class ImportProgress;
+
 class KaggleAPIClient {
 public:
+    static constexpr const char* DEFAULT_API_BASE_URL = "https://www.kaggle.com/api/v1";
+    static constexpr const char* API_BASE_URL_ENV = "ELOMETRY_KAGGLE_API_URL";
+    static constexpr long STREAM_BUFFER_SIZE = 256 * 1024;
+    static constexpr long LOW_SPEED_LIMIT_BYTES = 1024;
+    static constexpr long LOW_SPEED_TIME_SECONDS = 60;
+
     KaggleAPIClient();
     KaggleAPIClient(std::string_view username, std::string_view key);
     ~KaggleAPIClient();
@@ -22,7 +31,11 @@ public:
     KaggleAPIClient& operator=(KaggleAPIClient&&) noexcept;
 
     [[nodiscard]] time_t getDatasetLastUpdated(std::string_view dataset) const;
-    [[nodiscard]] bool downloadDataset(std::string_view dataset, std::string_view outputPath) const;
+    [[nodiscard]] bool downloadDataset(std::string_view dataset, 
+                                       std::string_view outputPath, 
+                                       ByteStream* stream = nullptr,
+                                      ImportProgress* progress = nullptr) const;
+    void setApiBaseUrl(std::string_view baseUrl) { m_apiBaseUrl = baseUrl; }
     
     [[nodiscard]] std::string_view getUsername() const noexcept { return m_username; }
     [[nodiscard]] std::string_view getKey() const noexcept { return m_key; }
@@ -43,6 +56,13 @@ private:
     std::string m_username;
     std::string m_key;
     std::string m_authHeader;
+    std::string m_apiBaseUrl{DEFAULT_API_BASE_URL};
+
+    struct DownloadTarget {
+        FILE* file;
+        ByteStream* stream;
+        ImportProgress* progress;
+    };
     
     [[nodiscard]] bool validateCredentials(bool requireAuth) const noexcept;
     [[nodiscard]] std::string makeApiRequest(std::string_view endpoint, bool requireAuth = true) const;
@@ -61,7 +81,7 @@ private:
     
     [[nodiscard]] bool setupDownloadRequest(
         CURL* curl,
-        FILE* fp,
+        DownloadTarget* target,
         curl_slist** headers
     ) const;
     
@@ -73,7 +93,11 @@ private:
     [[nodiscard]] std::optional<FILE*> openOutputFile(std::string_view outputPath) const;
     
     static size_t writeMemoryCallback(void* contents, size_t size, size_t nmemb, std::string* userp);
-    static size_t writeDataCallback(void* ptr, size_t size, size_t nmemb, FILE* stream);
+    [[nodiscard]] bool isLocalSource() const noexcept;
+    
+    static size_t writeDataCallback(void* ptr, size_t size, size_t nmemb, DownloadTarget* target);
+    static int transferInfoCallback(void* clientp, curl_off_t downloadTotal, curl_off_t downloaded,
+                                    curl_off_t uploadTotal, curl_off_t uploaded);
 };
 
 #endif
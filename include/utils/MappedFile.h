@@ -0,0 +1,38 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+class MappedFile {
+public:
+    explicit MappedFile(std::string_view path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_open; }
+    [[nodiscard]] const char* data() const noexcept { return m_data; }
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] std::string_view view() const noexcept { return {m_data, m_size}; }
+
+private:
+    const char* m_data{nullptr};
+    size_t m_size{0};
+    bool m_open{false};
+
+#ifdef _WIN32
+    void* m_fileHandle{nullptr};
+    void* m_mappingHandle{nullptr};
+#else
+    int m_fd{-1};
+#endif
+
+    void close() noexcept;
+};
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <compare>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// Process-wide store for the text of players and games. Every distinct string
+// is copied once into an append-only arena and never moves or dies, so the
+// views handed out stay valid for the lifetime of the program. Lookups go
+// through a hash set first, so club names, positions and dates that repeat
+// across thousands of rows share one copy, and reading the same players again
+// does not grow the arena.
+class StringPool {
+public:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+    static constexpr char EMPTY[1] = "";
+
+    [[nodiscard]] static StringPool& global();
+
+    // Returns the pooled, null-terminated copy of text.
+    [[nodiscard]] std::string_view intern(std::string_view text);
+
+    [[nodiscard]] size_t size() const;
+    [[nodiscard]] size_t arenaBytes() const;
+
+private:
+    mutable std::shared_mutex m_mutex;
+    std::unordered_set<std::string_view> m_strings;
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    char* m_block{nullptr};
+    size_t m_blockUsed{0};
+    size_t m_arenaBytes{0};
+
+    [[nodiscard]] char* allocate(size_t bytes);
+};
+
+// A handle to text in the global StringPool. It is as cheap to copy as a pointer
+// and converts to std::string_view and std::string wherever those are expected.
+class PooledString {
+public:
+    PooledString() noexcept = default;
+    PooledString(std::string_view text) : PooledString(StringPool::global().intern(text), Pooled{}) {}
+    PooledString(const std::string& text) : PooledString(std::string_view(text)) {}
+    PooledString(const char* text) : PooledString(std::string_view(text)) {}
+
+    [[nodiscard]] std::string_view view() const noexcept { return {m_data, m_size}; }
+    [[nodiscard]] std::string str() const { return std::string(view()); }
+    [[nodiscard]] const char* c_str() const noexcept { return m_data; }
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+    operator std::string_view() const noexcept { return view(); }
+    operator std::string() const { return str(); }
+
+    friend bool operator==(const PooledString& a, const PooledString& b) noexcept {
+        // Equal text always shares one pooled copy.
+        return a.m_data == b.m_data;
+    }
+    friend bool operator==(const PooledString& a, std::string_view b) noexcept { return a.view() == b; }
+    friend bool operator==(const PooledString& a, const std::string& b) noexcept { return a.view() == b; }
+    friend bool operator==(const PooledString& a, const char* b) noexcept { return a.view() == b; }
+    friend std::strong_ordering operator<=>(const PooledString& a, const PooledString& b) noexcept {
+        return a.view() <=> b.view();
+    }
+    friend std::strong_ordering operator<=>(const PooledString& a, std::string_view b) noexcept {
+        return a.view() <=> b;
+    }
+    friend std::strong_ordering operator<=>(const PooledString& a, const std::string& b) noexcept {
+        return a.view() <=> std::string_view(b);
+    }
+    friend std::ostream& operator<<(std::ostream& out, const PooledString& text) { return out << text.view(); }
+
+private:
+    struct Pooled {};
+
+    PooledString(std::string_view pooled, Pooled) noexcept
+        : m_data(pooled.data()), m_size(static_cast<uint32_t>(pooled.size())) {}
+
+    const char* m_data{StringPool::EMPTY};
+    uint32_t m_size{0};
+};
+
+template<>
+struct std::hash<PooledString> {
+    size_t operator()(const PooledString& text) const noexcept { return std::hash<const char*>{}(text.c_str()); }
+};
+
+#endif
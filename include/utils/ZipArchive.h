@@ -0,0 +1,119 @@
+#ifndef ZIPARCHIVE_H
+#define ZIPARCHIVE_H
+
+#include "utils/MappedFile.h"
+#include "utils/ByteStream.h"
+#include "utils/BoundedQueue.h"
+#include <zlib.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <optional>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+
+struct ZipEntry {
+    std::string name;
+    uint16_t method{0};
+    uint16_t flags{0};
+    uint32_t crc32{0};
+    uint64_t compressedSize{0};
+    uint64_t uncompressedSize{0};
+    uint64_t localHeaderOffset{0};
+};
+
+struct ZipStreamEntry {
+    std::string name;
+    std::shared_ptr<ByteStream> data;
+    uint64_t uncompressedSize{0};
+};
+
+[[nodiscard]] std::string_view zipFileName(std::string_view entryName) noexcept;
+
+class ZipEntryReader {
+public:
+    ZipEntryReader(const ZipEntry& entry, std::string_view compressedData);
+    ~ZipEntryReader();
+
+    ZipEntryReader(const ZipEntryReader&) = delete;
+    ZipEntryReader& operator=(const ZipEntryReader&) = delete;
+    ZipEntryReader(ZipEntryReader&&) = delete;
+    ZipEntryReader& operator=(ZipEntryReader&&) = delete;
+
+    [[nodiscard]] size_t read(std::span<char> buffer);
+    [[nodiscard]] bool failed() const noexcept { return m_failed; }
+    [[nodiscard]] bool finished() const noexcept { return m_finished; }
+    [[nodiscard]] uint64_t bytesRead() const noexcept { return m_bytesRead; }
+
+private:
+    ZipEntry m_entry;
+    std::string_view m_input;
+    size_t m_inputOffset{0};
+    z_stream m_stream{};
+    bool m_inflating{false};
+    bool m_failed{false};
+    bool m_finished{false};
+    uLong m_crc{0};
+    uint64_t m_bytesRead{0};
+
+    void complete();
+    void fail(std::string_view reason);
+};
+
+class ZipArchive {
+public:
+    explicit ZipArchive(std::string_view path);
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_open; }
+    [[nodiscard]] std::span<const ZipEntry> entries() const noexcept { return m_entries; }
+    [[nodiscard]] const ZipEntry* findEntry(std::string_view fileName) const;
+    [[nodiscard]] std::optional<std::string_view> entryData(const ZipEntry& entry) const;
+
+private:
+    MappedFile m_file;
+    std::vector<ZipEntry> m_entries;
+    bool m_open{false};
+
+    [[nodiscard]] bool readCentralDirectory();
+};
+
+class ZipStreamReader {
+public:
+    static constexpr size_t INFLATE_CHUNK_SIZE = 256 * 1024;
+    static constexpr size_t ENTRY_BUFFER_CHUNKS = 16;
+    static constexpr size_t MAX_PENDING_ENTRIES = 64;
+
+    ZipStreamReader(ByteStream& archive, std::function<bool(std::string_view fileName)> wanted);
+    ~ZipStreamReader();
+
+    ZipStreamReader(const ZipStreamReader&) = delete;
+    ZipStreamReader& operator=(const ZipStreamReader&) = delete;
+
+    [[nodiscard]] std::optional<ZipStreamEntry> nextEntry();
+    [[nodiscard]] bool failed() const noexcept { return m_failed; }
+
+private:
+    ByteStream& m_archive;
+    std::function<bool(std::string_view)> m_wanted;
+    BoundedQueue<ZipStreamEntry> m_entries;
+    std::string m_input;
+    size_t m_inputOffset{0};
+    std::atomic<bool> m_failed{false};
+    std::thread m_thread;
+
+    void run();
+    [[nodiscard]] bool readEntry();
+    [[nodiscard]] bool copyStored(const ZipEntry& entry, ByteStream* sink, uLong& crc, uint64_t& size);
+    [[nodiscard]] bool inflateEntry(const ZipEntry& entry, ByteStream* sink, uLong& crc, uint64_t& size);
+    [[nodiscard]] bool fill(size_t count);
+    [[nodiscard]] std::string_view available() const noexcept;
+    void consume(size_t count) noexcept { m_inputOffset += count; }
+    void drainArchive();
+};
+
+#endif
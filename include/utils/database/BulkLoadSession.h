@@ -0,0 +1,50 @@
+#ifndef BULKLOADSESSION_H
+#define BULKLOADSESSION_H
+
+#include <sqlite3.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <chrono>
+
+class BulkLoadSession {
+public:
+    static constexpr int BULK_CACHE_SIZE_KIB = 262144;
+
+    BulkLoadSession(sqlite3* db, std::span<const std::string> tableNames);
+    ~BulkLoadSession();
+
+    BulkLoadSession(const BulkLoadSession&) = delete;
+    BulkLoadSession& operator=(const BulkLoadSession&) = delete;
+    BulkLoadSession(BulkLoadSession&&) = delete;
+    BulkLoadSession& operator=(BulkLoadSession&&) = delete;
+
+    void markLoaded();
+    void finish();
+
+private:
+    struct SavedPragmas {
+        std::string journalMode;
+        std::string synchronous;
+        std::string cacheSize;
+        std::string tempStore;
+    };
+
+    sqlite3* m_db;
+    SavedPragmas m_savedPragmas;
+    std::vector<std::string> m_deferredIndexes;
+    std::chrono::steady_clock::time_point m_startTime;
+    std::chrono::steady_clock::time_point m_loadedTime;
+    bool m_finished{false};
+
+    void saveAndApplyPragmas();
+    void dropIndexes(std::span<const std::string> tableNames);
+    void rebuildIndexes();
+    void restorePragmas();
+
+    [[nodiscard]] std::string queryPragma(std::string_view pragma) const;
+    bool execute(const std::string& sql) const;
+};
+
+#endif
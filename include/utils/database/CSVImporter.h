@@ -0,0 +1,73 @@
+#ifndef CSVIMPORTER_H
+#define CSVIMPORTER_H
+
+#include "utils/database/ImportTypes.h"
+#include "utils/BoundedQueue.h"
+#include "utils/database/CSVSource.h"
+#include <sqlite3.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <span>
+#include <chrono>
+#include <cstddef>
+
+struct CSVRowBatch {
+    std::vector<std::string_view> fields;
+    std::deque<std::string> ownedFields;
+    std::vector<std::shared_ptr<const std::string>> inputChunks;
+    size_t rowCount{0};
+
+    // Keeps fields that point into the source's input as views; everything else is copied.
+    void appendRow(std::span<const std::string_view> rowFields, const CSVSource& source);
+};
+
+using CSVRowQueue = BoundedQueue<CSVRowBatch>;
+
+class CSVImporter {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 50000;
+    static constexpr size_t ROWS_PER_BATCH = 4096;
+    static constexpr size_t QUEUE_CAPACITY = 8;
+
+    explicit CSVImporter(sqlite3* db, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    [[nodiscard]] ImportStats importFile(std::string_view tableName, std::string_view csvPath);
+    [[nodiscard]] ImportStats importSource(const ImportSource& source);
+    [[nodiscard]] ImportStats importFrom(std::string_view tableName, CSVSource& source);
+    [[nodiscard]] ImportStats importBatches(std::string_view tableName,
+                                            std::span<const std::string> headers,
+                                            CSVRowQueue& queue);
+
+    static void produceBatches(CSVSource& source, size_t fieldCount, CSVRowQueue& queue, size_t& rowsSkipped);
+    [[nodiscard]] static std::string_view trim(std::string_view value);
+
+private:
+    enum class ColumnAffinity {
+        Integer,
+        Real,
+        Numeric,
+        Text
+    };
+
+    struct TargetColumn {
+        size_t fieldIndex;
+        ColumnAffinity affinity;
+    };
+
+    sqlite3* m_db;
+    size_t m_chunkSize;
+
+    [[nodiscard]] std::vector<std::pair<std::string, ColumnAffinity>> fetchTableColumns(std::string_view tableName) const;
+    [[nodiscard]] std::vector<TargetColumn> resolveTargetColumns(std::string_view tableName,
+                                                                 std::span<const std::string> headers,
+                                                                 std::string& insertQuery) const;
+    void bindField(sqlite3_stmt* stmt, int index, std::string_view value, ColumnAffinity affinity) const;
+    bool execute(const char* sql) const;
+
+    [[nodiscard]] static ColumnAffinity affinityFromDeclaredType(std::string_view declaredType);
+};
+
+#endif
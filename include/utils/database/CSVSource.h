@@ -0,0 +1,66 @@
+#ifndef CSVSOURCE_H
+#define CSVSOURCE_H
+
+#include "utils/database/ImportTypes.h"
+#include "utils/database/CSVTokenizer.h"
+#include "utils/MappedFile.h"
+#include "utils/ZipArchive.h"
+#include "utils/ByteStream.h"
+#include <string>
+#include <string_view>
+#include <span>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+class ImportProgress;
+
+class CSVSource {
+public:
+    static constexpr size_t STREAM_CHUNK_SIZE = 1 << 20;
+    static constexpr size_t PROGRESS_RECORD_INTERVAL = 4096;
+
+    explicit CSVSource(const ImportSource& source);
+    CSVSource(std::string label, std::shared_ptr<ByteStream> stream);
+    ~CSVSource();
+
+    CSVSource(const CSVSource&) = delete;
+    CSVSource& operator=(const CSVSource&) = delete;
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_open; }
+    [[nodiscard]] bool failed() const noexcept;
+    [[nodiscard]] const std::string& label() const noexcept { return m_label; }
+    void setProgress(ImportProgress* progress) noexcept { m_progress = progress; }
+
+    [[nodiscard]] bool nextRecord();
+    [[nodiscard]] std::span<const std::string_view> fields() const noexcept { return m_tokenizer.fields(); }
+
+    // The input the current record's fields point into. A mapped file stays put
+    // for the life of the source; a stream moves to a new chunk on every refill,
+    // and holding inputChunk() keeps the current one alive past that.
+    [[nodiscard]] std::string_view stableInput() const noexcept;
+    [[nodiscard]] const std::shared_ptr<const std::string>& inputChunk() const noexcept { return m_chunk; }
+
+    [[nodiscard]] static uint64_t sourceSize(const ImportSource& source);
+
+private:
+    std::string m_label;
+    std::unique_ptr<MappedFile> m_file;
+    std::unique_ptr<ZipArchive> m_archive;
+    std::unique_ptr<ZipEntryReader> m_entryReader;
+    std::shared_ptr<ByteStream> m_stream;
+    std::shared_ptr<const std::string> m_chunk;
+    CSVTokenizer m_tokenizer;
+    bool m_open{false};
+    ImportProgress* m_progress{nullptr};
+    uint64_t m_bytesRead{0};
+    uint64_t m_bytesReported{0};
+    size_t m_rowsPending{0};
+
+    [[nodiscard]] bool refill();
+    void reportProgress();
+    [[nodiscard]] bool streaming() const noexcept { return m_entryReader || m_stream; }
+    [[nodiscard]] bool streamFinished() const noexcept;
+};
+
+#endif
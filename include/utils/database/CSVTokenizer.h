@@ -0,0 +1,37 @@
+#ifndef CSVTOKENIZER_H
+#define CSVTOKENIZER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <span>
+#include <cstddef>
+
+class CSVTokenizer {
+public:
+    explicit CSVTokenizer(std::string_view input = {}, bool finalChunk = true);
+
+    void reset(std::string_view input, bool finalChunk = true);
+
+    [[nodiscard]] bool nextRecord();
+    [[nodiscard]] std::span<const std::string_view> fields() const noexcept { return m_fields; }
+    [[nodiscard]] size_t consumed() const noexcept { return m_position; }
+    [[nodiscard]] std::string_view input() const noexcept { return m_input; }
+    [[nodiscard]] std::string_view remaining() const noexcept { return m_input.substr(m_position); }
+
+private:
+    std::string_view m_input;
+    size_t m_position{0};
+    bool m_finalChunk{true};
+    std::vector<std::string_view> m_fields;
+    std::deque<std::string> m_unescaped;
+    size_t m_unescapedCount{0};
+
+    void emitField(size_t begin, size_t end, bool quoted, bool hasEscapes);
+    [[nodiscard]] std::string_view unescape(std::string_view raw);
+
+    [[nodiscard]] static size_t findSpecial(std::string_view input, size_t from, bool inQuotes) noexcept;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef CONNECTIONPOOL_H
+#define CONNECTIONPOOL_H
+
+#include "utils/database/StatementCache.h"
+#include <sqlite3.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+// Connections of the user database. Writes go through the single writer
+// connection; every thread that reads gets its own read-only connection, so
+// parallel loaders run their queries concurrently instead of taking turns on
+// the writer's mutex. A thread's reader is closed when the thread exits.
+class ConnectionPool {
+public:
+    // Runs on every reader right after it is opened, e.g. to attach the dataset.
+    using OpenHook = std::function<void(sqlite3*)>;
+
+    ConnectionPool(std::string dbPath, StatementCache& writer, OpenHook onOpen = {});
+    ~ConnectionPool();
+
+    ConnectionPool(const ConnectionPool&) = delete;
+    ConnectionPool& operator=(const ConnectionPool&) = delete;
+    ConnectionPool(ConnectionPool&&) = delete;
+    ConnectionPool& operator=(ConnectionPool&&) = delete;
+
+    [[nodiscard]] StatementCache& writer() const noexcept { return m_writer; }
+
+    // The calling thread's read-only connection, opened on first use. Falls back
+    // to the writer when the database cannot be opened read-only.
+    [[nodiscard]] StatementCache& reader();
+
+    // Closes every reader so the next read reopens with the current attachments.
+    // No reader statement may be in use on any thread.
+    void closeReaders();
+    [[nodiscard]] size_t readerCount() const;
+
+private:
+    struct Reader {
+        sqlite3* db{nullptr};
+        std::unique_ptr<StatementCache> statements;
+    };
+
+    // Shared with the threads that own a reader, so a thread exiting after the
+    // pool is destroyed finds its entry gone instead of touching a dead pool.
+    struct Readers {
+        std::mutex mutex;
+        std::unordered_map<std::thread::id, Reader> byThread;
+    };
+
+    class ThreadReaders;
+
+    std::string m_dbPath;
+    StatementCache& m_writer;
+    OpenHook m_onOpen;
+    std::shared_ptr<Readers> m_readers{std::make_shared<Readers>()};
+
+    [[nodiscard]] sqlite3* openReader() const;
+    static void release(Readers& readers, std::thread::id threadId);
+    static void close(Reader& reader);
+};
+
+#endif
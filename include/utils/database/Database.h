@@ -9,10 +9,20 @@
 #include <span>
 #include <optional>
 #include <memory>
+#include <cstdint>
+#include <mutex>
+#include "utils/database/ImportTypes.h"
+#include "utils/database/StatementCache.h"
+#include "utils/database/ConnectionPool.h"
 
 class KaggleAPIClient;
+class ParallelImporter;
+class DatasetBuild;
+class DatasetPatch;
+class ByteStream;
+class ImportProgress;
+class QueryPlanAuditor;
 
-using ProgressCallback = std::function<void(const std::string&, int)>;
 using PlayerId = int;
 
 class Database {
@@ -26,53 +36,120 @@ public:
     Database& operator=(Database&&) noexcept = delete;
 
     [[nodiscard]] sqlite3* getConnection() const;
+    [[nodiscard]] const std::string& getPath() const noexcept { return m_dbPath; }
+    [[nodiscard]] ConnectionPool& connections() const noexcept { return *m_connections; }
+    // Null unless QueryPlanAuditor::ENVIRONMENT_VARIABLE was set when the database was opened.
+    [[nodiscard]] QueryPlanAuditor* queryAuditor() const noexcept { return m_queryAuditor.get(); }
 
     [[nodiscard]] std::string getKaggleUsername() const;
     [[nodiscard]] std::string getKaggleKey() const;
     void setKaggleCredentials(std::string_view username, std::string_view key);
-    void loadCSVIntoTable(std::string_view tableName, std::string_view csvPath);
+    ImportStats loadCSVIntoTable(std::string_view tableName, std::string_view csvPath);
     void executeSQLFile(std::string_view filePath);
     [[nodiscard]] bool isNewDatabase() const;
     void initialize(ProgressCallback progressCallback = nullptr);
+    void setBulkLoadEnabled(bool enabled) noexcept { m_bulkLoadEnabled = enabled; }
+    [[nodiscard]] const DatasetChangeSet& getLastChangeSet() const noexcept { return m_lastChangeSet; }
+    [[nodiscard]] std::filesystem::path replayCachePath() const;
+    [[nodiscard]] int64_t datasetVersion() const;
+
+    // Downloads a newer Kaggle dataset, if there is one, and compares it with the
+    // current rows. Only the returned patch is written, so this can run on a worker
+    // while the dataset is read. Null when there is nothing to apply.
+    [[nodiscard]] std::unique_ptr<DatasetPatch> prepareDatasetUpdate(ProgressCallback progressCallback = nullptr);
+    // Writes a prepared update into the dataset. No other thread may read the
+    // database meanwhile. True when dataset rows changed.
+    bool applyDatasetUpdate(std::unique_ptr<DatasetPatch> patch, ProgressCallback progressCallback = nullptr);
+    // Stops a download started by prepareDatasetUpdate on another thread, which then returns null.
+    void cancelDatasetUpdate();
+
+    // False for dataset tables that imports skip. They keep the rows an earlier dataset or
+    // the legacy database left in them, but those rows are not kept up to date.
+    [[nodiscard]] bool isTableLoaded(std::string_view tableName) const;
 
 private:
+    static constexpr const char* DATASET_NAME = "davidcariboo/player-scores";
+    static constexpr const char* DATASET_FILE_NAME = "dataset.db";
+    static constexpr const char* REPLAY_CACHE_FILE_NAME = "replay.cache";
+    static constexpr const char* DATASET_SCHEMA = "dataset";
+    static constexpr const char* DATASET_SCHEMA_PATH = "../db/data.sql";
+    static constexpr const char* USER_SCHEMA_PATH = "../db/user.sql";
+    static constexpr const char* COMPACT_SCHEMA_PATH = "../db/compact.sql";
+    static constexpr const char* COMPACT_DELTA_SCHEMA_PATH = "../db/compact_delta.sql";
+    static constexpr const char* USER_INDEXES_PATH = "../db/user_indexes.sql";
+    static constexpr int COMPACT_SCHEMA_VERSION = 3;
+    static constexpr int64_t DATASET_MMAP_SIZE = 1LL << 30;
+    static constexpr int BUSY_TIMEOUT_MS = 5000;
+    static constexpr const char* DATASET_ARCHIVE_PATH = "player-scores.zip";
+    static constexpr size_t ARCHIVE_STREAM_CHUNKS = 256;
+    static constexpr const char* DEFERRED_TABLES_KEY = "deferred_tables";
+    static constexpr const char* IMPORT_TELEMETRY_KEY = "last_import_telemetry";
+
     struct MetadataRecord {
         std::string key;
         std::string value;
     };
 
     sqlite3* m_db{nullptr};
+    std::unique_ptr<StatementCache> m_statementCache;
+    std::unique_ptr<ConnectionPool> m_connections;
     std::string m_dbPath;
     bool m_newDatabase{false};
+    bool m_bulkLoadEnabled{true};
+    bool m_datasetAttached{false};
+    DatasetChangeSet m_lastChangeSet;
+    ImportProgress* m_importProgress{nullptr};
+    std::string m_importTelemetry;
+    std::mutex m_archiveStreamMutex;
+    ByteStream* m_archiveStream{nullptr};
     mutable std::unique_ptr<KaggleAPIClient> m_kaggleClient;
+    std::unique_ptr<QueryPlanAuditor> m_queryAuditor;
 
     [[nodiscard]] bool fileExists(std::string_view filePath) const;
     [[nodiscard]] bool isDatabaseInitialized() const;
-    [[nodiscard]] bool tableExists(std::string_view tableName) const;
+    [[nodiscard]] bool tableExists(std::string_view tableName, std::string_view schema = "main") const;
     [[nodiscard]] bool tableHasData(std::string_view tableName) const;
     [[nodiscard]] bool metadataHasEntry(std::string_view key) const;
 
-    void loadDataIntoDatabase(bool updateDataset, ProgressCallback progressCallback);
-    void updateDatasetIfNeeded(ProgressCallback progressCallback);
-    [[nodiscard]] bool downloadAndExtractDataset(bool updateDataset, ProgressCallback progressCallback);
+    [[nodiscard]] std::filesystem::path datasetPath() const;
+    bool attachDataset();
+    bool attachDatasetTo(sqlite3* db) const;
+    void prepareReader(sqlite3* db) const;
+    void detachDataset();
+    [[nodiscard]] bool swapDataset(DatasetBuild& build);
+    void migrateLegacyDataset();
+    [[nodiscard]] static bool copyTables(sqlite3* datasetDb,
+                                         const std::string& sourcePath,
+                                         std::span<const std::string> tables,
+                                         bool withRowHashes);
+    [[nodiscard]] static bool buildCompactSchema(sqlite3* datasetDb);
+    [[nodiscard]] int compactSchemaVersion() const;
+    void ensureCompactSchema();
+
+    void loadDataIntoDatabase(ProgressCallback progressCallback);
+    // Imports a whole new dataset next to the current one and swaps it in.
+    [[nodiscard]] bool buildDataset(ProgressCallback progressCallback);
+    void finishDatasetLoad(ProgressCallback progressCallback);
+    [[nodiscard]] bool importDataset(sqlite3* db, bool applyDelta, ProgressCallback progressCallback);
+    void recordImportTelemetry();
+    [[nodiscard]] bool streamDatasetIntoDatabase(sqlite3* db,
+                                                 std::span<const std::string> tableNames,
+                                                 bool applyDelta,
+                                                 ProgressCallback progressCallback);
+    [[nodiscard]] std::vector<ImportSource> collectImportSources(std::span<const std::string> tableNames) const;
+    void importTables(sqlite3* db, std::span<const ImportSource> sources, ProgressCallback progressCallback);
+    void runFullImport(sqlite3* db,
+                       std::span<const std::string> tableNames,
+                       ProgressCallback progressCallback,
+                       const std::function<std::vector<ImportStats>(ParallelImporter&)>& runImport);
     void setLastUpdateTimestamp();
     [[nodiscard]] time_t getLastUpdateTimestamp() const;
     [[nodiscard]] std::string getMetadataValue(std::string_view key) const;
     void setMetadataValue(std::string_view key, std::string_view value);
     [[nodiscard]] time_t getKaggleDatasetLastUpdated() const;
     [[nodiscard]] std::string formatTimestamp(time_t timestamp) const;
-    void compareAndUpdateDataset(time_t kaggleUpdatedTime, ProgressCallback progressCallback);
-
-    [[nodiscard]] std::vector<std::string> getSanitizedValues(std::ifstream& file, std::string& line) const;
-    [[nodiscard]] std::string sanitizeCSVValue(std::string_view value) const;
-    [[nodiscard]] std::string buildInsertQuery(std::string_view tableName, 
-                                              std::span<const std::string> columns, 
-                                              std::ifstream& file) const;
-    void appendCSVRowsToQuery(std::ifstream& file, std::stringstream& sqlBatch, bool& firstRow) const;
-    void appendRowValuesToQuery(std::span<const std::string> values, std::stringstream& sqlBatch) const;
-    void executeCSVImportQuery(std::string_view query, std::string_view csvPath, std::string_view tableName);
-    [[nodiscard]] std::string joinStrings(std::span<const std::string> values, std::string_view delimiter) const;
 
+    [[nodiscard]] static std::string readSQLFile(std::string_view filePath);
     static size_t WriteDataCallback(void* ptr, size_t size, size_t nmemb, FILE* stream);
 };
 
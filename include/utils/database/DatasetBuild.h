@@ -0,0 +1,36 @@
+#ifndef DATASETBUILD_H
+#define DATASETBUILD_H
+
+#include <sqlite3.h>
+#include <string>
+#include <string_view>
+#include <filesystem>
+
+class DatasetBuild {
+public:
+    DatasetBuild(std::filesystem::path targetPath, std::string_view schemaSql, bool fromExisting);
+    ~DatasetBuild();
+
+    DatasetBuild(const DatasetBuild&) = delete;
+    DatasetBuild& operator=(const DatasetBuild&) = delete;
+    DatasetBuild(DatasetBuild&&) = delete;
+    DatasetBuild& operator=(DatasetBuild&&) = delete;
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_db != nullptr; }
+    [[nodiscard]] sqlite3* connection() const noexcept { return m_db; }
+    [[nodiscard]] const std::filesystem::path& buildPath() const noexcept { return m_buildPath; }
+
+    [[nodiscard]] bool commit();
+
+private:
+    std::filesystem::path m_targetPath;
+    std::filesystem::path m_buildPath;
+    sqlite3* m_db{nullptr};
+    bool m_committed{false};
+
+    bool execute(const std::string& sql) const;
+    void close();
+    static void removeFiles(const std::filesystem::path& path);
+};
+
+#endif
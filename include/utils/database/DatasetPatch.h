@@ -0,0 +1,50 @@
+#ifndef DATASETPATCH_H
+#define DATASETPATCH_H
+
+#include <sqlite3.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <filesystem>
+
+// Collects the changes of a dataset update in a small side file while the dataset
+// stays readable, then writes them into the dataset in place. The connection sees
+// the current dataset read-only as LIVE_SCHEMA and an empty copy of each table in
+// main, which receives the new and changed rows.
+class DatasetPatch {
+public:
+    static constexpr const char* LIVE_SCHEMA = "live";
+    // Rows of the current dataset that the patch replaces or deletes, by rowid.
+    static constexpr const char* REPLACED_ROWS_TABLE = "dataset_replaced_rows";
+
+    DatasetPatch(std::filesystem::path datasetPath, std::span<const std::string> tableNames);
+    ~DatasetPatch();
+
+    DatasetPatch(const DatasetPatch&) = delete;
+    DatasetPatch& operator=(const DatasetPatch&) = delete;
+    DatasetPatch(DatasetPatch&&) = delete;
+    DatasetPatch& operator=(DatasetPatch&&) = delete;
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_db != nullptr; }
+    [[nodiscard]] sqlite3* connection() const noexcept { return m_db; }
+
+    // Replaces the patched rows and their row hashes in one transaction, then runs
+    // maintenanceSql in it with the replaced rows in temp.previous_<table> and the new
+    // ones in patch.<table>. Nothing else may have the dataset attached meanwhile.
+    [[nodiscard]] bool apply(std::string_view maintenanceSql);
+
+private:
+    std::filesystem::path m_datasetPath;
+    std::filesystem::path m_patchPath;
+    std::vector<std::string> m_tableNames;
+    sqlite3* m_db{nullptr};
+
+    bool createTables();
+    static bool attach(sqlite3* db, const std::filesystem::path& path, std::string_view schema);
+    static bool execute(sqlite3* db, const std::string& sql);
+    void close();
+    static void removeFiles(const std::filesystem::path& path);
+};
+
+#endif
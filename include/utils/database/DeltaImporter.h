@@ -0,0 +1,73 @@
+#ifndef DELTAIMPORTER_H
+#define DELTAIMPORTER_H
+
+#include "utils/database/ImportTypes.h"
+#include "utils/database/CSVSource.h"
+#include "utils/ZipArchive.h"
+#include <sqlite3.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <unordered_map>
+#include <cstdint>
+
+class ImportProgress;
+
+// Compares CSV rows against the row hashes of a DatasetPatch's live dataset and
+// writes what changed into the patch: new and changed rows, their hashes and the
+// live rows they replace or delete.
+class DeltaImporter {
+public:
+    explicit DeltaImporter(sqlite3* patchDb);
+
+    void setProgress(ImportProgress* progress) noexcept { m_progress = progress; }
+
+    [[nodiscard]] DatasetChangeSet applyChanges(std::span<const ImportSource> sources,
+                                                const ProgressCallback& progressCallback,
+                                                int baseProgress,
+                                                int progressRange);
+    [[nodiscard]] DatasetChangeSet applyStreamChanges(ZipStreamReader& entries,
+                                                      std::span<const std::string> tableNames,
+                                                      const ProgressCallback& progressCallback,
+                                                      int baseProgress,
+                                                      int progressRange);
+
+private:
+    struct RowHash {
+        uint64_t keyHash;
+        std::string rowKey;
+        uint64_t rowHash;
+        bool replacesRow;
+    };
+
+    struct TableDelta {
+        TableChanges changes;
+        std::vector<RowHash> changedRows;
+        std::vector<uint64_t> deletedKeys;
+        std::vector<int> touchedGameIds;
+        bool failed{false};
+    };
+
+    sqlite3* m_db;
+    ImportProgress* m_progress{nullptr};
+
+    [[nodiscard]] TableDelta applyTableChanges(const std::string& tableName, CSVSource& csv);
+    void recordTableDelta(DatasetChangeSet& changeSet, const TableDelta& delta);
+    [[nodiscard]] std::unordered_map<uint64_t, uint64_t> loadRowHashes(std::string_view tableName) const;
+    [[nodiscard]] std::vector<std::string> fetchKeyColumns(std::string_view tableName,
+                                                           std::span<const std::string> headers) const;
+    [[nodiscard]] std::vector<std::string> fetchIndexColumns(std::string_view indexName) const;
+    void storeRowHashes(std::string_view tableName, std::span<const RowHash> rows);
+    void recordReplacedRows(std::string_view tableName,
+                            std::span<const std::string> keyColumns,
+                            bool hasGameId,
+                            TableDelta& delta);
+    bool execute(const std::string& sql) const;
+
+    static void finishChangeSet(DatasetChangeSet& changeSet);
+    [[nodiscard]] static uint64_t hashBytes(std::string_view bytes, uint64_t seed) noexcept;
+    [[nodiscard]] static std::vector<std::string_view> splitRowKey(std::string_view rowKey);
+};
+
+#endif
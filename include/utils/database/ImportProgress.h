@@ -0,0 +1,75 @@
+#ifndef IMPORTPROGRESS_H
+#define IMPORTPROGRESS_H
+
+#include "utils/database/ImportTypes.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <cstdint>
+
+class ImportProgress {
+public:
+    enum class Stage { Download, Parse };
+
+    static constexpr std::chrono::milliseconds REPORT_INTERVAL{250};
+    static constexpr double RATE_SMOOTHING = 0.3;
+
+    ImportProgress(ProgressCallback progressCallback, int baseProgress, int progressRange);
+    ~ImportProgress();
+
+    ImportProgress(const ImportProgress&) = delete;
+    ImportProgress& operator=(const ImportProgress&) = delete;
+
+    void setStatus(std::string status);
+    [[nodiscard]] ProgressCallback statusCallback();
+
+    void addExpectedBytes(Stage stage, uint64_t bytes) noexcept;
+    void setExpectedBytes(Stage stage, uint64_t bytes) noexcept;
+    void addProcessedBytes(Stage stage, uint64_t bytes) noexcept;
+    void setProcessedBytes(Stage stage, uint64_t bytes) noexcept;
+    void addRows(uint64_t rows) noexcept;
+
+    ImportTelemetry stop();
+
+    [[nodiscard]] static std::string formatSummary(const ImportTelemetry& telemetry);
+
+private:
+    struct StageCounters {
+        std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> expected{0};
+    };
+
+    ProgressCallback m_progressCallback;
+    int m_baseProgress;
+    int m_progressRange;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    std::array<StageCounters, 2> m_stages;
+    std::atomic<uint64_t> m_rows{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::string m_status;
+    bool m_stopped{false};
+    std::thread m_reporter;
+
+    ImportTelemetry m_telemetry;
+    std::chrono::steady_clock::time_point m_lastSample;
+    uint64_t m_lastBytes{0};
+    uint64_t m_lastRows{0};
+    double m_lastFraction{0.0};
+    double m_fractionRate{0.0};
+
+    void run();
+    void sample();
+    void report();
+
+    [[nodiscard]] StageCounters& counters(Stage stage) noexcept { return m_stages[static_cast<size_t>(stage)]; }
+    [[nodiscard]] static std::string formatRate(const ImportTelemetry& telemetry);
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef IMPORTTYPES_H
+#define IMPORTTYPES_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+using ProgressCallback = std::function<void(const std::string&, int)>;
+
+struct ImportSource {
+    std::string tableName;
+    std::string csvPath;
+    std::string archivePath;
+};
+
+struct ImportStats {
+    std::string tableName;
+    size_t rowsImported{0};
+    size_t rowsSkipped{0};
+    std::chrono::milliseconds elapsed{0};
+    bool failed{false};
+    // Positions, in queue order, of the queued rows the table rejected.
+    std::vector<size_t> rejectedRows{};
+};
+
+struct ImportTelemetry {
+    uint64_t bytesParsed{0};
+    uint64_t bytesExpected{0};
+    uint64_t bytesDownloaded{0};
+    uint64_t downloadExpected{0};
+    uint64_t rowsParsed{0};
+    double bytesPerSecond{0.0};
+    double rowsPerSecond{0.0};
+    double fraction{0.0};
+    std::chrono::milliseconds elapsed{0};
+    std::optional<std::chrono::seconds> eta;
+};
+
+struct TableChanges {
+    std::string tableName;
+    size_t inserted{0};
+    size_t updated{0};
+    size_t deleted{0};
+    size_t unchanged{0};
+    bool fullReload{false};
+};
+
+struct DatasetChangeSet {
+    std::vector<TableChanges> tables;
+    std::vector<int> touchedGameIds;
+    bool fullReload{false};
+
+    [[nodiscard]] bool empty() const noexcept;
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef NAMESEARCH_H
+#define NAMESEARCH_H
+
+#include "utils/database/StatementCache.h"
+#include <string_view>
+#include <vector>
+#include <functional>
+
+using NameSearchFunction = std::function<std::vector<int>(std::string_view)>;
+
+// Looks up ids in one of the trigram name indexes built with the compact dataset tables.
+class NameSearch {
+public:
+    static constexpr size_t TRIGRAM_LENGTH = 3;
+
+    // Ids of every name containing text, case-insensitively, best matches first.
+    // Text shorter than a trigram falls back to a LIKE scan of the index.
+    [[nodiscard]] static std::vector<int> search(StatementCache& statements, std::string_view indexTable, std::string_view text);
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef PARALLELIMPORTER_H
+#define PARALLELIMPORTER_H
+
+#include "utils/database/ImportTypes.h"
+#include "utils/database/CSVImporter.h"
+#include "utils/ZipArchive.h"
+#include <sqlite3.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <filesystem>
+#include <cstdint>
+
+class ImportProgress;
+
+class ParallelImporter {
+public:
+    static constexpr int STAGING_CACHE_SIZE_KIB = 65536;
+
+    ParallelImporter(sqlite3* db, std::filesystem::path stagingDirectory, unsigned maxConcurrentTables = 0);
+
+    void setProgress(ImportProgress* progress) noexcept { m_progress = progress; }
+
+    [[nodiscard]] std::vector<ImportStats> importTables(std::span<const ImportSource> sources,
+                                                        const ProgressCallback& progressCallback,
+                                                        int baseProgress,
+                                                        int progressRange);
+    [[nodiscard]] std::vector<ImportStats> importStream(ZipStreamReader& entries,
+                                                        std::span<const std::string> tableNames,
+                                                        const ProgressCallback& progressCallback,
+                                                        int baseProgress,
+                                                        int progressRange);
+
+private:
+    sqlite3* m_db;
+    std::filesystem::path m_stagingDirectory;
+    unsigned m_maxConcurrentTables;
+    ImportProgress* m_progress{nullptr};
+
+    [[nodiscard]] std::string fetchCreateStatement(std::string_view tableName) const;
+    [[nodiscard]] std::string fetchPrimaryKeyColumns(std::string_view tableName) const;
+    [[nodiscard]] std::filesystem::path stagingPath(std::string_view tableName) const;
+    bool mergeStaging(std::string_view tableName, const std::filesystem::path& path);
+    void mergeResult(ImportStats& stats, bool inSchema);
+    bool execute(const std::string& sql) const;
+
+    [[nodiscard]] static ImportStats importIntoStaging(std::string_view tableName,
+                                                       CSVSource& source,
+                                                       const std::string& createStatement,
+                                                       const std::filesystem::path& path);
+    static void removeStagingFiles(const std::filesystem::path& path);
+};
+
+#endif
@@ -13,7 +13,7 @@ public:
     static std::optional<Player> tryMapPlayerFromStatement(sqlite3_stmt* stmt);
     
 private:
-    static std::string extractTextColumn(sqlite3_stmt* stmt, int columnIndex);
+    static PooledString extractTextColumn(sqlite3_stmt* stmt, int columnIndex);
     
     static int extractIntColumn(sqlite3_stmt* stmt, int columnIndex);
     
@@ -0,0 +1,72 @@
+#ifndef QUERYPLANAUDITOR_H
+#define QUERYPLANAUDITOR_H
+
+#include <sqlite3.h>
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+struct FullScan {
+    std::string table;
+    std::string detail;
+};
+
+struct QueryAuditEntry {
+    std::string sql;
+    size_t executions{0};
+    std::chrono::nanoseconds totalTime{0};
+    std::chrono::nanoseconds maxTime{0};
+    std::vector<FullScan> fullScans;
+};
+
+// Records every statement a connection runs and checks its EXPLAIN QUERY PLAN for
+// full scans of the large dataset tables. Enabled by setting ELOMETRY_QUERY_AUDIT.
+class QueryPlanAuditor {
+public:
+    static constexpr const char* ENVIRONMENT_VARIABLE = "ELOMETRY_QUERY_AUDIT";
+    static constexpr std::array<std::string_view, 10> LARGE_TABLES{
+        "players_compact", "games_compact", "appearances_compact", "players", "games",
+        "appearances", "game_events", "game_lineups", "player_valuations", "club_games"
+    };
+
+    explicit QueryPlanAuditor(sqlite3* db);
+    ~QueryPlanAuditor();
+
+    QueryPlanAuditor(const QueryPlanAuditor&) = delete;
+    QueryPlanAuditor& operator=(const QueryPlanAuditor&) = delete;
+    QueryPlanAuditor(QueryPlanAuditor&&) = delete;
+    QueryPlanAuditor& operator=(QueryPlanAuditor&&) = delete;
+
+    [[nodiscard]] static bool isEnabled();
+    // Plan rows of sql that scan a large table, whether the plan names the table or its alias.
+    [[nodiscard]] static std::vector<FullScan> findFullScans(sqlite3* db, std::string_view sql);
+
+    // Records the statements of another connection too. It must be closed before the auditor.
+    void watch(sqlite3* db);
+
+    [[nodiscard]] std::vector<QueryAuditEntry> report() const;
+    // Forgets the statements recorded so far.
+    void clear();
+    // Prints latency for every recorded query and returns false when any of them scans a large table.
+    bool printReport() const;
+
+private:
+    struct Timing {
+        size_t executions{0};
+        std::chrono::nanoseconds totalTime{0};
+        std::chrono::nanoseconds maxTime{0};
+    };
+
+    sqlite3* m_db;
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Timing> m_timings;
+
+    static int traceCallback(unsigned type, void* context, void* statement, void* elapsed);
+    void record(std::string sql, std::chrono::nanoseconds elapsed);
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef REPLAYCACHE_H
+#define REPLAYCACHE_H
+
+#include "utils/MappedFile.h"
+#include <sqlite3.h>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <cstdint>
+
+// Games are ordered by day. The appearances of game i are [appearanceOffsets[i], appearanceOffsets[i + 1]).
+struct ReplayColumns {
+    std::span<const int32_t> gameIds;
+    std::span<const int32_t> gameDays;
+    std::span<const int32_t> homeClubIds;
+    std::span<const int32_t> awayClubIds;
+    std::span<const uint8_t> homeGoals;
+    std::span<const uint8_t> awayGoals;
+    std::span<const uint32_t> appearanceOffsets;
+
+    std::span<const int32_t> playerIds;
+    std::span<const int32_t> clubIds;
+    std::span<const uint8_t> goals;
+    std::span<const uint8_t> assists;
+    std::span<const uint8_t> minutesPlayed;
+
+    std::span<const int32_t> nameClubIds;
+    std::span<const uint32_t> nameOffsets;
+    std::string_view nameData;
+
+    [[nodiscard]] std::string_view clubName(int32_t clubId) const;
+};
+
+class ReplayCache {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    ReplayCache(const std::filesystem::path& path, int64_t datasetVersion);
+
+    ReplayCache(const ReplayCache&) = delete;
+    ReplayCache& operator=(const ReplayCache&) = delete;
+    ReplayCache(ReplayCache&&) = delete;
+    ReplayCache& operator=(ReplayCache&&) = delete;
+
+    [[nodiscard]] bool isOpen() const noexcept { return m_open; }
+    [[nodiscard]] const ReplayColumns& columns() const noexcept { return m_columns; }
+
+    static bool write(sqlite3* db, const std::filesystem::path& path, int64_t datasetVersion);
+
+private:
+    struct Header {
+        char magic[4];
+        uint32_t formatVersion;
+        int64_t datasetVersion;
+        uint32_t gameCount;
+        uint32_t appearanceCount;
+        uint32_t clubCount;
+        uint32_t nameBytes;
+    };
+
+    static constexpr char MAGIC[4] = {'E', 'L', 'R', 'C'};
+    static constexpr size_t COLUMN_ALIGNMENT = 8;
+
+    std::unique_ptr<MappedFile> m_file;
+    ReplayColumns m_columns;
+    bool m_open{false};
+
+    [[nodiscard]] bool mapColumns(const Header& header);
+};
+
+#endif
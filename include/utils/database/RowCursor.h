@@ -0,0 +1,104 @@
+#ifndef ROWCURSOR_H
+#define ROWCURSOR_H
+
+#include "utils/database/StatementCache.h"
+#include <sqlite3.h>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Rows of a bound statement, mapped one at a time as the range is iterated.
+// Stopping early hands the statement back to its cache without reading the
+// remaining rows. A cursor is a single-pass input range and has to be consumed
+// on the thread that created it, since it holds that thread's reader statement.
+template<typename T>
+class RowCursor : public std::ranges::view_interface<RowCursor<T>> {
+public:
+    using Mapper = T (*)(sqlite3_stmt*);
+
+    class iterator {
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(RowCursor* cursor) noexcept : m_cursor(cursor) {}
+
+        const T& operator*() const { return *m_cursor->m_current; }
+        const T* operator->() const { return &*m_cursor->m_current; }
+
+        iterator& operator++() {
+            m_cursor->step();
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept {
+            return it.atEnd();
+        }
+
+    private:
+        RowCursor* m_cursor{nullptr};
+
+        [[nodiscard]] bool atEnd() const noexcept { return !m_cursor || !m_cursor->m_current; }
+    };
+
+    RowCursor() = default;
+    RowCursor(StatementLease statement, Mapper mapper)
+        : m_statement(std::move(statement)), m_mapper(mapper) {}
+
+    RowCursor(const RowCursor&) = delete;
+    RowCursor& operator=(const RowCursor&) = delete;
+    RowCursor(RowCursor&&) noexcept = default;
+    RowCursor& operator=(RowCursor&&) noexcept = default;
+
+    // Reads the first row; a cursor can only be iterated once.
+    iterator begin() {
+        if (!m_started) {
+            m_started = true;
+            step();
+        }
+        return iterator{this};
+    }
+
+    [[nodiscard]] std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+    [[nodiscard]] std::vector<T> collect() && {
+        std::vector<T> rows;
+        for (auto it = begin(); it != end(); ++it) {
+            rows.push_back(std::move(*m_current));
+        }
+        return rows;
+    }
+
+    // Maps at most one row and releases the statement straight away.
+    [[nodiscard]] std::optional<T> first() && {
+        begin();
+        std::optional<T> row = std::move(m_current);
+        m_current.reset();
+        m_statement = StatementLease{};
+        return row;
+    }
+
+private:
+    StatementLease m_statement;
+    Mapper m_mapper{nullptr};
+    std::optional<T> m_current;
+    bool m_started{false};
+
+    void step() {
+        if (m_statement && sqlite3_step(m_statement) == SQLITE_ROW) {
+            m_current = m_mapper(m_statement);
+            return;
+        }
+
+        m_current.reset();
+        m_statement = StatementLease{};
+    }
+};
+
+#endif
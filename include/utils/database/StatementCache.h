@@ -0,0 +1,90 @@
+#ifndef STATEMENTCACHE_H
+#define STATEMENTCACHE_H
+
+#include <sqlite3.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class StatementCache;
+
+// A prepared statement borrowed from a StatementCache. It is reset, unbound and
+// handed back to the cache when the lease goes out of scope.
+class StatementLease {
+public:
+    StatementLease() = default;
+    ~StatementLease();
+
+    StatementLease(const StatementLease&) = delete;
+    StatementLease& operator=(const StatementLease&) = delete;
+    StatementLease(StatementLease&& other) noexcept;
+    StatementLease& operator=(StatementLease&& other) noexcept;
+
+    [[nodiscard]] sqlite3_stmt* get() const noexcept { return m_stmt; }
+    operator sqlite3_stmt*() const noexcept { return m_stmt; }
+
+private:
+    friend class StatementCache;
+
+    StatementLease(StatementCache* cache, std::vector<sqlite3_stmt*>* slot, sqlite3_stmt* stmt) noexcept
+        : m_cache(cache), m_slot(slot), m_stmt(stmt) {}
+
+    void release() noexcept;
+
+    StatementCache* m_cache{nullptr};
+    std::vector<sqlite3_stmt*>* m_slot{nullptr};
+    sqlite3_stmt* m_stmt{nullptr};
+};
+
+struct StatementCacheStats {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    size_t idleStatements{0};
+};
+
+// Prepared statements of one connection, keyed by SQL text. Leases must be
+// returned before the cache is destroyed.
+class StatementCache {
+public:
+    static constexpr size_t MAX_IDLE_STATEMENTS = 128;
+
+    explicit StatementCache(sqlite3* db);
+    ~StatementCache();
+
+    StatementCache(const StatementCache&) = delete;
+    StatementCache& operator=(const StatementCache&) = delete;
+    StatementCache(StatementCache&&) = delete;
+    StatementCache& operator=(StatementCache&&) = delete;
+
+    // Returns an empty lease when the SQL does not compile; sqlite3_errmsg has the reason.
+    [[nodiscard]] StatementLease acquire(std::string_view sql);
+    [[nodiscard]] StatementCacheStats stats() const;
+    [[nodiscard]] sqlite3* connection() const noexcept { return m_db; }
+
+    // Finalizes every idle statement, e.g. before the schema they were compiled against goes away.
+    void clear();
+
+private:
+    friend class StatementLease;
+
+    struct SqlHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view sql) const noexcept { return std::hash<std::string_view>{}(sql); }
+    };
+
+    sqlite3* m_db;
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, std::vector<sqlite3_stmt*>, SqlHash, std::equal_to<>> m_idle;
+    size_t m_idleCount{0};
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+
+    void release(std::vector<sqlite3_stmt*>& slot, sqlite3_stmt* stmt) noexcept;
+};
+
+#endif
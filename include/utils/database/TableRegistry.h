@@ -0,0 +1,18 @@
+#ifndef TABLEREGISTRY_H
+#define TABLEREGISTRY_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+
+class TableRegistry {
+public:
+    [[nodiscard]] static std::span<const std::string> datasetTables();
+    [[nodiscard]] static const std::vector<std::string>& requiredTables();
+    [[nodiscard]] static const std::vector<std::string>& deferredTables();
+    [[nodiscard]] static bool isRequired(std::string_view tableName);
+    [[nodiscard]] static bool isDeferred(std::string_view tableName);
+};
+
+#endif
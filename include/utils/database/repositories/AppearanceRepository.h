@@ -2,7 +2,10 @@
 #define APPEARANCE_REPOSITORY_H
 
 #include "utils/database/Database.h"
+#include "utils/database/RowCursor.h"
 #include <vector>
+#include <array>
+#include <string_view>
 #include <memory>
 #include <optional>
 #include <span>
@@ -18,6 +21,8 @@ struct PlayerAppearance {
 
 class AppearanceRepository {
 public:
+    static constexpr std::array<std::string_view, 2> REQUIRED_TABLES{"appearances", "games"};
+    
     explicit AppearanceRepository(Database& database);
     ~AppearanceRepository() = default;
     
@@ -27,20 +32,20 @@ public:
     AppearanceRepository& operator=(AppearanceRepository&&) noexcept = default;
     
     [[nodiscard]] std::vector<PlayerAppearance> fetchAppearances() const;
+    [[nodiscard]] RowCursor<PlayerAppearance> scanAppearances() const;
     [[nodiscard]] std::vector<PlayerAppearance> fetchPlayerAppearances(PlayerId playerId) const;
     [[nodiscard]] std::vector<PlayerAppearance> fetchGameAppearances(int gameId) const;
     [[nodiscard]] std::optional<PlayerAppearance> fetchAppearance(PlayerId playerId, int gameId) const;
 
 private:
-    static constexpr auto BASE_QUERY = "SELECT game_id, player_id, player_club_id, goals, assists, minutes_played FROM appearances";
+    static constexpr auto BASE_QUERY = "SELECT game_id, player_id, club_id, goals, assists, minutes_played FROM appearances_compact";
     
-    sqlite3* m_db;
+    ConnectionPool* m_connections;
     
     template<typename... Args>
-    [[nodiscard]] std::vector<PlayerAppearance> executeQuery(const std::string& query, Args... args) const;
+    [[nodiscard]] RowCursor<PlayerAppearance> scanQuery(const std::string& query, Args... args) const;
     
-    [[nodiscard]] std::vector<PlayerAppearance> bindAndExecute(sqlite3_stmt* stmt) const;
-    [[nodiscard]] PlayerAppearance extractAppearanceFromStatement(sqlite3_stmt* stmt) const;
+    [[nodiscard]] static PlayerAppearance extractAppearanceFromStatement(sqlite3_stmt* stmt);
 };
 
 #endif
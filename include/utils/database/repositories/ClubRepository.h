@@ -2,7 +2,9 @@
 #define CLUBREPOSITORY_H
 
 #include "utils/database/Database.h"
+#include "utils/database/RowCursor.h"
 #include <vector>
+#include <array>
 #include <string_view>
 #include <optional>
 #include <concepts>
@@ -16,7 +18,10 @@ struct Club {
 
 class ClubRepository {
 public:
+    static constexpr std::array<std::string_view, 2> REQUIRED_TABLES{"clubs", "competitions"};
+    
     explicit ClubRepository(Database& database);
+    explicit ClubRepository(ConnectionPool& connections);
     ~ClubRepository() = default;
     
     ClubRepository(const ClubRepository&) = delete;
@@ -25,15 +30,20 @@ public:
     ClubRepository& operator=(ClubRepository&&) noexcept = default;
     
     [[nodiscard]] std::vector<Club> fetchClubs(std::optional<int> clubId = std::nullopt) const;
+    [[nodiscard]] RowCursor<Club> scanClubs(std::optional<int> clubId = std::nullopt) const;
     [[nodiscard]] std::optional<Club> fetchClubById(int clubId) const;
+    [[nodiscard]] std::vector<int> searchClubIds(std::string_view text) const;
     
 private:
+    static constexpr auto BASE_QUERY = 
+        "SELECT c.club_id, n.name FROM clubs_compact c LEFT JOIN club_names n ON n.club_id = c.club_id";
+    
     template<std::integral... Params>
-    [[nodiscard]] std::vector<Club> executeQuery(std::string_view query, Params... params) const;
+    [[nodiscard]] RowCursor<Club> scanQuery(std::string_view query, Params... params) const;
     
     [[nodiscard]] static Club extractClubFromStatement(sqlite3_stmt* stmt);
     
-    sqlite3* m_db;
+    ConnectionPool* m_connections;
 };
 
 #endif
@@ -2,7 +2,12 @@
 #define GAMEREPOSITORY_H
 
 #include "utils/database/Database.h"
+#include "utils/database/RowCursor.h"
+#include "utils/DayDate.h"
+#include "utils/StringPool.h"
 #include <vector>
+#include <array>
+#include <string_view>
 #include <string>
 #include <optional>
 
@@ -12,13 +17,15 @@ struct Game {
     int awayClubId{0};
     int homeGoals{0};
     int awayGoals{0};
-    std::string homeClubName;
-    std::string awayClubName;
-    std::string date;
+    PooledString homeClubName;
+    PooledString awayClubName;
+    DayNumber day{0};
 };
 
 class GameRepository {
 public:
+    static constexpr std::array<std::string_view, 3> REQUIRED_TABLES{"games", "clubs", "competitions"};
+    
     explicit GameRepository(Database& db);
     ~GameRepository() = default;
     
@@ -28,6 +35,7 @@ public:
     GameRepository& operator=(GameRepository&&) = default;
     
     [[nodiscard]] std::vector<Game> fetchGames() const;
+    [[nodiscard]] RowCursor<Game> scanGames() const;
     [[nodiscard]] std::optional<Game> fetchGameById(int gameId) const;
     [[nodiscard]] std::vector<Game> fetchGamesForClub(int clubId) const;
     [[nodiscard]] std::vector<Game> fetchRecentGames(int limit = 10) const;
@@ -35,30 +43,28 @@ public:
 private:
     static constexpr auto BASE_QUERY = R"(
         SELECT 
-            cg.game_id, 
-            cg.club_id AS home_club_id, 
-            cg.own_goals AS home_goals, 
-            cg.opponent_id AS away_club_id, 
-            cg.opponent_goals AS away_goals,
+            g.game_id, 
+            g.home_club_id, 
+            g.home_goals, 
+            g.away_club_id, 
+            g.away_goals,
             h.name AS home_club_name,
             a.name AS away_club_name,
-            g.date AS game_date
+            g.day
         FROM 
-            club_games cg
+            games_compact g
         LEFT JOIN 
-            clubs h ON cg.club_id = h.club_id
+            club_names h ON g.home_club_id = h.club_id
         LEFT JOIN 
-            clubs a ON cg.opponent_id = a.club_id
-        LEFT JOIN
-            games g ON cg.game_id = g.game_id
+            club_names a ON g.away_club_id = a.club_id
     )";
     
     template<typename... Args>
-    [[nodiscard]] std::vector<Game> executeQuery(const std::string& query, Args... args) const;
+    [[nodiscard]] RowCursor<Game> scanQuery(const std::string& query, Args... args) const;
     
-    [[nodiscard]] Game extractGameFromStatement(sqlite3_stmt* stmt) const;
+    [[nodiscard]] static Game extractGameFromStatement(sqlite3_stmt* stmt);
     
-    sqlite3* m_db;
+    ConnectionPool* m_connections;
 };
 
 #endif
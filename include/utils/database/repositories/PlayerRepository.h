@@ -2,20 +2,24 @@
 #define PLAYERREPOSITORY_H
 
 #include "utils/database/Database.h"
+#include "utils/database/RowCursor.h"
+#include "utils/StringPool.h"
 #include <vector>
+#include <array>
 #include <optional>
 #include <string_view>
 #include <span>
+#include <unordered_map>
 
 struct Player {
     int playerId;
     int clubId;
-    std::string name;
-    std::string clubName;
-    std::string subPosition;
-    std::string position;
-    std::string contractExpirationDate;
-    std::string imageUrl;
+    PooledString name;
+    PooledString clubName;
+    PooledString subPosition;
+    PooledString position;
+    PooledString contractExpirationDate;
+    PooledString imageUrl;
     int marketValue = 0;
     int highestMarketValue = 0;
 
@@ -25,8 +29,10 @@ struct Player {
 
 class PlayerRepository {
 public:
+    static constexpr std::array<std::string_view, 2> REQUIRED_TABLES{"players", "clubs"};
+    
     explicit PlayerRepository(Database& database);
-    explicit PlayerRepository(sqlite3* db);
+    explicit PlayerRepository(ConnectionPool& connections);
     
     PlayerRepository(const PlayerRepository&) = delete;
     PlayerRepository& operator=(const PlayerRepository&) = delete;
@@ -38,15 +44,40 @@ public:
                                                    std::optional<int> playerId = std::nullopt,
                                                    std::optional<int> teamId = std::nullopt) const;
 
+    // Same filters as fetchPlayers, yielding rows as they are read.
+    [[nodiscard]] RowCursor<Player> scanPlayers(std::optional<int> clubId = std::nullopt,
+                                                std::optional<int> playerId = std::nullopt,
+                                                std::optional<int> teamId = std::nullopt) const;
+
     [[nodiscard]] std::optional<Player> fetchPlayerById(int playerId) const;
     [[nodiscard]] std::vector<Player> fetchPlayersByClub(int clubId) const;
     [[nodiscard]] std::vector<Player> fetchPlayersByTeam(int teamId) const;
+    [[nodiscard]] std::vector<int> searchPlayerIds(std::string_view text) const;
+    // Players of every saved team, read in a single query and keyed by team id.
+    [[nodiscard]] std::unordered_map<int, std::vector<Player>> fetchPlayersByAllTeams() const;
 
 private:
-    sqlite3* m_db;
+    static constexpr auto PLAYER_COLUMNS = R"(
+            p.player_id, 
+            p.club_id, 
+            p.name, 
+            c.name, 
+            sp.name, 
+            pp.name, 
+            p.contract_expiration_day, 
+            p.market_value, 
+            p.highest_market_value,
+            p.image_url)";
+
+    static constexpr auto PLAYER_JOINS = R"(
+        LEFT JOIN club_names c ON c.club_id = p.club_id
+        LEFT JOIN position_codes sp ON sp.position_code = p.sub_position_code
+        LEFT JOIN position_codes pp ON pp.position_code = p.position_code)";
+
+    ConnectionPool* m_connections;
 
-    [[nodiscard]] std::vector<Player> executeQuery(std::string_view query, 
-                                                   std::span<const std::pair<int, int>> params = {}) const;
+    [[nodiscard]] RowCursor<Player> scanQuery(std::string_view query, 
+                                              std::span<const std::pair<int, int>> params = {}) const;
 };
 
 #endif
@@ -3,8 +3,9 @@
 
 #include "utils/database/Database.h"
 #include "models/PlayerRating.h"
-#include "gui/models/LineupTypes.h"
+#include "models/LineupTypes.h"
 #include <vector>
+#include <array>
 #include <string>
 #include <string_view>
 #include <optional>
@@ -27,6 +28,8 @@ struct Team {
 
 class TeamRepository {
 public:
+    static constexpr std::array<std::string_view, 1> REQUIRED_TABLES{"players"};
+    
     explicit TeamRepository(Database& database);
     
     [[nodiscard]] std::vector<std::string> getAvailableSubPositions() const;
@@ -60,12 +63,13 @@ private:
     [[nodiscard]] bool executeStatement(sqlite3_stmt* stmt, 
                                        std::span<const std::pair<int, int>> intBindings = {}, 
                                        std::span<const std::pair<int, std::string>> textBindings = {}) const;
-    [[nodiscard]] bool prepareStatement(std::string_view query, sqlite3_stmt** stmt) const;
+    [[nodiscard]] StatementLease prepareStatement(std::string_view query) const;
     [[nodiscard]] bool deactivateTeamLineups(int teamId) const;
     [[nodiscard]] bool fillLineupPlayerPositions(Lineup& lineup) const;
     [[nodiscard]] bool saveLineupPlayers(const Lineup& lineup) const;
     
     sqlite3* m_db;
+    StatementCache* m_statements;
 };
 
 #endif
@@ -2,6 +2,7 @@
 #include "services/RatingManager.h"
 #include "services/TeamManager.h"
 #include "utils/database/Database.h"
+#include "utils/database/DatasetPatch.h"
 
 #include <QCoreApplication>
 #include <QTimer>
@@ -19,6 +20,8 @@ DataLoader::DataLoader(RatingManager& ratingManager,
     , m_database(database)
 {}
 
+DataLoader::~DataLoader() = default;
+
 void DataLoader::loadData() {
     notifyProgress("Connecting to database", 10);
     initializeDatabase();
@@ -30,6 +33,18 @@ void DataLoader::loadData() {
     emit loadingComplete();
 }
 
+void DataLoader::prepareDatasetUpdate() {
+    m_pendingUpdate = m_database.prepareDatasetUpdate();
+    emit datasetUpdatePrepared();
+}
+
+void DataLoader::applyDatasetUpdate() {
+    if (m_database.applyDatasetUpdate(std::move(m_pendingUpdate))) {
+        m_ratingManager.loadAndProcessRatings();
+        m_teamManager.loadTeams();
+    }
+}
+
 void DataLoader::initializeDatabase() {
     auto progressCallback = [this](const std::string& status, int progress) {
         emit progressUpdate(QString::fromStdString(status), progress);
@@ -6,10 +6,14 @@
 #include <QStandardItemModel>
 #include <algorithm>
 #include <ranges>
+#include <unordered_set>
 
-ClubSelectDialog::ClubSelectDialog(std::span<const std::pair<int, std::string>> clubs, QWidget* parent)
+ClubSelectDialog::ClubSelectDialog(std::span<const std::pair<int, std::string>> clubs, 
+                                   NameSearchFunction clubSearch,
+                                   QWidget* parent)
     : QDialog(parent),
-      m_availableClubs(clubs.begin(), clubs.end())
+      m_availableClubs(clubs.begin(), clubs.end()),
+      m_clubSearch(std::move(clubSearch))
 {
     setupUi();
     setupConnections();
@@ -85,10 +89,18 @@ QStandardItemModel* ClubSelectDialog::createFilteredModel(const QString& filter)
     auto* model = new QStandardItemModel(0, 2, const_cast<ClubSelectDialog*>(this));
     model->setHeaderData(0, Qt::Horizontal, tr("ID"));
     model->setHeaderData(1, Qt::Horizontal, tr("Club Name"));
+
+    std::optional<std::unordered_set<int>> matches;
+    if (!filter.isEmpty() && m_clubSearch) {
+        const auto ids = m_clubSearch(filter.toStdString());
+        matches.emplace(ids.begin(), ids.end());
+    }
     
     for (const auto& [id, name] : m_availableClubs) {
         QString clubName = QString::fromStdString(name);
-        if (filter.isEmpty() || clubName.contains(filter, Qt::CaseInsensitive)) {
+        const bool matchesFilter = filter.isEmpty() || 
+                                   (matches ? matches->contains(id) : clubName.contains(filter, Qt::CaseInsensitive));
+        if (matchesFilter) {
             QList<QStandardItem*> row;
             row.append(new QStandardItem(QString::number(id)));
             row.append(new QStandardItem(clubName));
@@ -163,6 +163,7 @@ void PlayerSelectDialog::createPlayerSelectModel() {
     }
     
     m_playersModel = std::make_unique<PlayerSelectModel>(allPlayers, this);
+    m_playersModel->setNameSearch([this](std::string_view text) { return m_teamManager.searchPlayerIds(text); });
     m_playersTable->setModel(m_playersModel.get());
     
     connect(m_playersModel.get(), &QAbstractItemModel::dataChanged, 
@@ -68,6 +68,10 @@ bool PlayerListModel::matchesFilter(const std::pair<int, Player>& player) const
     if (m_currentFilter.isEmpty()) {
         return true;
     }
+
+    if (m_nameMatches) {
+        return m_nameMatches->contains(player.first);
+    }
     
     return QString::fromStdString(player.second.name)
         .contains(m_currentFilter, Qt::CaseInsensitive);
@@ -89,6 +93,16 @@ void PlayerListModel::applyFilters() {
     m_filteredPlayers.assign(filteredView.begin(), filteredView.end());
 }
 
+void PlayerListModel::refreshNameMatches() {
+    m_nameMatches.reset();
+    if (m_currentFilter.isEmpty() || !m_nameSearch) {
+        return;
+    }
+
+    const auto ids = m_nameSearch(m_currentFilter.toStdString());
+    m_nameMatches.emplace(ids.begin(), ids.end());
+}
+
 int PlayerListModel::filteredPlayerCount() const noexcept {
     return static_cast<int>(m_filteredPlayers.size());
 }
@@ -108,6 +122,7 @@ void PlayerListModel::setFilter(const QString& filter) {
     beginResetModel();
     m_currentFilter = filter;
     
+    refreshNameMatches();
     applyFilters();
     m_startIndex = 0;
     
@@ -226,8 +226,9 @@ void PlayerSelectModel::applyFilters() {
     
     auto shouldRemove = [this](const auto& player) {
         const bool matchesNameFilter = m_currentFilter.isEmpty() || 
-                                      QString::fromStdString(player.second.name)
-                                          .contains(m_currentFilter, Qt::CaseInsensitive);
+                                      (m_nameMatches ? m_nameMatches->contains(player.first)
+                                                     : QString::fromStdString(player.second.name)
+                                                           .contains(m_currentFilter, Qt::CaseInsensitive));
                                           
         const bool matchesPositionFilter = m_currentPosition.isEmpty() || 
                                           player.second.subPosition == m_currentPosition.toStdString() || 
@@ -242,9 +243,20 @@ void PlayerSelectModel::applyFilters() {
     );
 }
 
+void PlayerSelectModel::refreshNameMatches() {
+    m_nameMatches.reset();
+    if (m_currentFilter.isEmpty() || !m_nameSearch) {
+        return;
+    }
+
+    const auto ids = m_nameSearch(m_currentFilter.toStdString());
+    m_nameMatches.emplace(ids.begin(), ids.end());
+}
+
 void PlayerSelectModel::setFilter(const QString& filter) {
     beginResetModel();
     m_currentFilter = filter;
+    refreshNameMatches();
     applyFilters();
     m_startIndex = 0;
     endResetModel();
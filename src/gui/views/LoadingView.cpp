@@ -8,6 +8,7 @@
 LoadingView::LoadingView(QWidget* parent)
     : QWidget(parent)
     , m_statusLabel(nullptr)
+    , m_detailLabel(nullptr)
     , m_appNameLabel(nullptr)
     , m_progressBar(nullptr)
     , m_progressAnimation(std::make_unique<QPropertyAnimation>())
@@ -40,10 +41,12 @@ void LoadingView::setupLayout() {
     m_appNameLabel = new QLabel("Elometry", this);
     m_progressBar = new QProgressBar(this);
     m_statusLabel = new QLabel("Initializing", this);
+    m_detailLabel = new QLabel(this);
     
     mainLayout->addWidget(m_appNameLabel);
     mainLayout->addWidget(m_progressBar);
     mainLayout->addWidget(m_statusLabel);
+    mainLayout->addWidget(m_detailLabel);
     
     mainLayout->addStretch();
 }
@@ -74,6 +77,10 @@ void LoadingView::setupStatusLabel() {
     QFont statusFont("Segoe UI", 12);
     m_statusLabel->setFont(statusFont);
     m_statusLabel->setStyleSheet("color: #a0a0a0;");
+
+    m_detailLabel->setAlignment(Qt::AlignCenter);
+    m_detailLabel->setFont(QFont("Segoe UI", 10));
+    m_detailLabel->setStyleSheet("color: #707070;");
 }
 
 void LoadingView::setupAnimations() {
@@ -103,7 +110,16 @@ void LoadingView::setupAppNameAnimation() {
     m_appNameAnimation->setEasingCurve(QEasingCurve::OutBack);
 }
 
-void LoadingView::updateStatus(const QString& status) {
+void LoadingView::updateStatus(const QString& text) {
+    const qsizetype lineBreak = text.indexOf('\n');
+    const QString status = lineBreak < 0 ? text : text.left(lineBreak);
+    m_detailLabel->setText(lineBreak < 0 ? QString() : text.mid(lineBreak + 1));
+
+    if (status == m_currentStatus) {
+        return;
+    }
+    m_currentStatus = status;
+
     m_statusOpacityAnimation->setStartValue(1.0);
     m_statusOpacityAnimation->setEndValue(0.0);
     
@@ -42,6 +42,14 @@ MainWindow::MainWindow(RatingManager& ratingManager, TeamManager& teamManager, D
     setWindowTitle("Elometry");
 }
 
+MainWindow::~MainWindow() {
+    if (m_loadingThread->isRunning()) {
+        m_database.cancelDatasetUpdate();
+        m_loadingThread->quit();
+        m_loadingThread->wait();
+    }
+}
+
 void MainWindow::setupUserInterface() {
     createMainMenu();
     
@@ -176,6 +184,11 @@ void MainWindow::navigateToMainMenu() {
     
     connect(m_fadeAnimation.get(), &QPropertyAnimation::finished, this, [this, target]() {
         m_stackedWidget->setCurrentWidget(target);
+
+        if (m_datasetUpdatePending) {
+            applyDatasetUpdate();
+        }
+
         m_fadeAnimation->setDirection(QPropertyAnimation::Forward);
         m_fadeAnimation->start();
         disconnect(m_fadeAnimation.get(), &QPropertyAnimation::finished, this, nullptr);
@@ -186,6 +199,7 @@ void MainWindow::navigateToMainMenu() {
 void MainWindow::initializeApplication() {
     auto* dataLoader = new DataLoader(m_ratingManager, m_teamManager, m_database);
     dataLoader->moveToThread(m_loadingThread.get());
+    m_dataLoader = dataLoader;
     m_loadingView->updateStatus("Starting");
     m_loadingView->updateProgress(0);
     
@@ -197,6 +211,11 @@ void MainWindow::initializeApplication() {
     
     connect(dataLoader, &DataLoader::progressUpdate, this, &MainWindow::handleDataLoadProgress, 
             Qt::QueuedConnection);
+
+    connect(dataLoader, &DataLoader::datasetUpdatePrepared, this, &MainWindow::applyDatasetUpdate, 
+            Qt::QueuedConnection);
+
+    connect(m_loadingThread.get(), &QThread::finished, dataLoader, &QObject::deleteLater);
     
     QTimer::singleShot(100, [this]() {
         m_loadingThread->start();
@@ -214,13 +233,41 @@ void MainWindow::handleDataLoadProgress(const QString& status, int progress) {
 
 void MainWindow::transitionToMainView() {
     setupUserInterface();
-    
-    if (m_loadingThread->isRunning()) {
-        m_loadingThread->quit();
-        m_loadingThread->wait();
-    }
-    
     showMainView();
+
+    // The loader thread stays up to download and compare a newer dataset while the
+    // application is in use.
+    QMetaObject::invokeMethod(m_dataLoader, &DataLoader::prepareDatasetUpdate, Qt::QueuedConnection);
+}
+
+void MainWindow::applyDatasetUpdate() {
+    // The views read ratings and the dataset directly, so the update waits until
+    // none of them is open or being navigated to.
+    if (m_stackedWidget->currentWidget() != m_mainMenuView ||
+        m_fadeAnimation->state() == QAbstractAnimation::Running) {
+        m_datasetUpdatePending = true;
+        return;
+    }
+    m_datasetUpdatePending = false;
+
+    // Closing the views first also stops their background searches, which read
+    // the ratings being replaced.
+    const bool rebuildViews = m_dataLoader->hasDatasetUpdate();
+    if (rebuildViews) {
+        m_playerListView.reset();
+        m_teamManagerView.reset();
+        m_settingsView.reset();
+    }
+
+    m_dataLoader->applyDatasetUpdate();
+
+    if (rebuildViews) {
+        initializeViews();
+    }
+
+    m_loadingThread->quit();
+    m_loadingThread->wait();
+    m_dataLoader = nullptr;
 }
 
 void MainWindow::showMainView() {
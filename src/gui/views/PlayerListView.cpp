@@ -30,6 +30,8 @@ PlayerListView::PlayerListView(RatingManager& ratingManager, TeamManager& teamMa
     , m_model(std::make_unique<PlayerListModel>(ratingManager.getSortedRatedPlayers()))
     , m_networkManager(std::make_unique<QNetworkAccessManager>(this))
 {
+    m_model->setNameSearch([this](std::string_view text) { return m_teamManager.searchPlayerIds(text); });
+
     setupUi();
     setupAnimations();
     setupConnections();
@@ -12,6 +12,7 @@
 #include <QtWidgets/QScrollArea>
 #include <QtGui/QStandardItem>
 #include <QTimer>
+#include <QLocale>
 #include <QInputDialog>
 #include <QEasingCurve>
 #include <QParallelAnimationGroup>
@@ -19,7 +20,9 @@
 #include <QFutureWatcher>
 #include <QtConcurrent>
 #include <algorithm>
+#include <cmath>
 #include <ranges>
+#include <utility>
 
 TeamManagerView::TeamManagerView(TeamManager& teamManager, QWidget* parent)
     : QWidget(parent)
@@ -48,6 +51,18 @@ TeamManagerView::TeamManagerView(TeamManager& teamManager, QWidget* parent)
 TeamManagerView::~TeamManagerView() {
     disconnect(this, nullptr, nullptr, nullptr);
 
+    if (m_autoFillWatcher) {
+        m_autoFillStopSource.request_stop();
+        m_autoFillWatcher->disconnect();
+        m_autoFillWatcher->waitForFinished();
+    }
+
+    if (m_previewWatcher) {
+        m_previewStopSource.request_stop();
+        m_previewWatcher->disconnect();
+        m_previewWatcher->waitForFinished();
+    }
+
     delete m_teamListOpacityAnimation;
     delete m_teamPlayersOpacityAnimation;
     delete m_playerDetailsOpacityAnimation; 
@@ -281,6 +296,11 @@ void TeamManagerView::setupCenterPanelBudget(QVBoxLayout* layout) {
     budgetLayout->addWidget(m_budgetInput, 1);
     
     layout->addLayout(budgetLayout);
+
+    m_autoFillPreviewLabel = new QLabel(this);
+    m_autoFillPreviewLabel->setWordWrap(true);
+    m_autoFillPreviewLabel->setStyleSheet("font-size: 12px; color: #aaaaaa;");
+    layout->addWidget(m_autoFillPreviewLabel);
 }
 
 void TeamManagerView::setupCenterPanelButtons(QVBoxLayout* layout) {
@@ -729,14 +749,20 @@ void TeamManagerView::updateTeamRatingLabel(double averageRating, double ratingD
 }
 
 void TeamManagerView::updateTeamInfo() {
+    m_previewMissingPositions.clear();
+    m_exactAutoFill.reset();
+
     if (!m_currentTeam) {
         m_currentTeamPlayers->setModel(nullptr);
         disableTeamControls();
         
         updateTeamRatingDisplay();
+        refreshAutoFillPreview();
         return;
     }
 
+    m_previewMissingPositions = m_teamManager.getMissingPositions(*m_currentTeam);
+
     QAbstractItemModel* oldModel = m_currentTeamPlayers->model();
     QStandardItemModel* playerModel = createPlayerModel();
     
@@ -747,7 +773,12 @@ void TeamManagerView::updateTeamInfo() {
     }
 
     enableTeamControls();
-    m_budgetInput->setValue(m_currentTeam->budget);
+    
+    if (m_budgetInput->value() != m_currentTeam->budget) {
+        m_budgetInput->setValue(m_currentTeam->budget);
+    } else {
+        refreshAutoFillPreview();
+    }
     
     updateTeamRatingDisplay();
     
@@ -1297,7 +1328,9 @@ void TeamManagerView::showClubSelectionDialog() {
         loadAvailableClubs();
     }
     
-    ClubSelectDialog dialog(m_availableClubs, this);
+    ClubSelectDialog dialog(m_availableClubs, 
+                            [this](std::string_view text) { return m_teamManager.searchClubIds(text); },
+                            this);
 
     if (dialog.exec() == QDialog::Accepted) {
         if (auto clubIdOpt = dialog.getSelectedClubId()) {
@@ -1344,17 +1377,155 @@ void TeamManagerView::autoFillTeam() {
         return;
     }
 
+    if (m_autoFillWatcher) {
+        return;
+    }
+
+    if (m_exactAutoFill && m_exactAutoFill->teamId == m_currentTeam->teamId &&
+        m_exactAutoFill->budget == m_budgetInput->value()) {
+        const SelectionResult result = std::move(m_exactAutoFill->result);
+        applyAutoFillResult(m_currentTeam->teamId, result);
+        return;
+    }
+
+    try {
+        auto missingPositions = m_teamManager.getMissingPositions(*m_currentTeam);
+        if (missingPositions.empty()) {
+            return;
+        }
+
+        startAutoFill(std::move(missingPositions), m_budgetInput->value());
+    } catch (const std::exception& e) {
+        reportAutoFillError(e);
+    }
+}
+
+void TeamManagerView::startAutoFill(std::vector<std::string> missingPositions, int64_t budget) {
+    const int teamId = m_currentTeam->teamId;
+    m_autoFillStopSource = std::stop_source{};
+
+    SelectionOptions options;
+    options.timeLimitMs = AUTO_FILL_TIME_LIMIT_MS;
+    options.stopToken = m_autoFillStopSource.get_token();
+    options.onProgress = [this](const SelectionProgress& progress) {
+        QMetaObject::invokeMethod(this, [this, progress]() {
+            updateAutoFillProgress(progress);
+        }, Qt::QueuedConnection);
+    };
+
+    m_autoFillProgress = new QProgressDialog("Searching for the optimal team...", "Stop", 0, 0, this);
+    m_autoFillProgress->setWindowTitle("Auto-Fill Team");
+    m_autoFillProgress->setWindowModality(Qt::WindowModal);
+    m_autoFillProgress->setMinimumDuration(300);
+    m_autoFillProgress->setAutoClose(false);
+    m_autoFillProgress->setAutoReset(false);
+    connect(m_autoFillProgress, &QProgressDialog::canceled, this, &TeamManagerView::cancelAutoFill);
+
+    m_autoFillButton->setEnabled(false);
+
+    m_autoFillWatcher = new QFutureWatcher<SelectionResult>(this);
+    connect(m_autoFillWatcher, &QFutureWatcher<SelectionResult>::finished, this, [this, teamId]() {
+        finishAutoFill(teamId);
+    });
+
+    m_autoFillWatcher->setFuture(QtConcurrent::run(
+        [this, positions = std::move(missingPositions), budget, options = std::move(options)]() {
+            return m_teamManager.planAutoFill(positions, budget, options);
+        }));
+}
+
+void TeamManagerView::cancelAutoFill() {
+    m_autoFillStopSource.request_stop();
+
+    if (m_autoFillProgress) {
+        m_autoFillProgress->setLabelText("Stopping, keeping the best team found so far...");
+    }
+}
+
+void TeamManagerView::updateAutoFillProgress(const SelectionProgress& progress) {
+    if (!m_autoFillProgress) {
+        return;
+    }
+
+    m_autoFillProgress->setLabelText(
+        QString("Improved team found after %1 ms\nObjective: %2, optimality gap: %3%")
+            .arg(progress.elapsed.count())
+            .arg(progress.incumbentObjective, 0, 'f', 1)
+            .arg(progress.gap * 100.0, 0, 'f', 2)
+    );
+}
+
+void TeamManagerView::finishAutoFill(int teamId) {
+    QFutureWatcher<SelectionResult>* watcher = std::exchange(m_autoFillWatcher, nullptr);
+    watcher->deleteLater();
+
+    if (m_autoFillProgress) {
+        m_autoFillProgress->close();
+        m_autoFillProgress->deleteLater();
+        m_autoFillProgress = nullptr;
+    }
+
+    SelectionResult result;
+    try {
+        result = watcher->result();
+    } catch (const std::exception& e) {
+        reportAutoFillError(e);
+        return;
+    }
+
+    applyAutoFillResult(teamId, result);
+}
+
+void TeamManagerView::applyAutoFillResult(int teamId, const SelectionResult& result) {
     try {
-        m_teamManager.autoFillTeam(*m_currentTeam, m_budgetInput->value());
-        m_teamManager.saveTeamPlayers(*m_currentTeam);
+        Team& team = m_teamManager.loadTeam(teamId);
+        m_teamManager.applyAutoFill(team, result);
+        m_teamManager.saveTeamPlayers(team);
+    } catch (const std::exception& e) {
+        reportAutoFillError(e);
+        return;
+    }
+
+    if (m_currentTeam && m_currentTeam->teamId == teamId) {
         updateTeamInfo();
         m_teamPlayersOpacityAnimation->start();
-    } catch (const std::exception& e) {
-        QMessageBox::critical(
-            this, 
-            "Error", 
-            QString("Failed to auto-fill team: %1").arg(e.what())
-        );
+    } else {
+        m_autoFillButton->setEnabled(m_currentTeam != nullptr);
+    }
+
+    if (result.status != SelectionStatus::Optimal) {
+        QMessageBox::information(this, "Auto-Fill Team", describeAutoFillResult(result));
+    }
+}
+
+void TeamManagerView::reportAutoFillError(const std::exception& e) {
+    m_autoFillButton->setEnabled(m_currentTeam != nullptr);
+
+    QMessageBox::critical(
+        this, 
+        "Error", 
+        QString("Failed to auto-fill team: %1").arg(e.what())
+    );
+}
+
+QString TeamManagerView::describeAutoFillResult(const SelectionResult& result) const {
+    switch (result.status) {
+        case SelectionStatus::Optimal:
+            return "Optimal team found.";
+        case SelectionStatus::TimeLimit:
+            return QString("Time limit reached after %1 ms. Using the best team found (gap %2%).")
+                .arg(result.elapsed.count())
+                .arg(result.gap * 100.0, 0, 'f', 2);
+        case SelectionStatus::Cancelled:
+            return result.team.empty()
+                ? QString("Auto-fill stopped before a team was found.")
+                : QString("Auto-fill stopped. Using the best team found (gap %1%).")
+                    .arg(result.gap * 100.0, 0, 'f', 2);
+        case SelectionStatus::Failed:
+            return "Auto-fill failed.";
+        case SelectionStatus::Infeasible:
+        default:
+            return "No team satisfies the budget and position requirements.";
     }
 }
 
@@ -1362,6 +1533,144 @@ void TeamManagerView::updateBudget(int newBudget) {
     if (m_currentTeam) {
         m_teamManager.setTeamBudget(m_currentTeam->teamId, newBudget);
     }
+
+    refreshAutoFillPreview();
+}
+
+void TeamManagerView::refreshAutoFillPreview() {
+    m_exactAutoFill.reset();
+
+    if (!m_currentTeam) {
+        m_previewStopSource.request_stop();
+        m_autoFillPreviewLabel->clear();
+        return;
+    }
+
+    if (m_previewMissingPositions.empty()) {
+        m_previewStopSource.request_stop();
+        m_autoFillPreviewLabel->setText("All positions are filled.");
+        return;
+    }
+
+    // Only the greedy team is built here; its LP bound is computed with the exact solve.
+    const SelectionPreview preview = m_teamManager.previewAutoFill(
+        m_previewMissingPositions, m_budgetInput->value(), PreviewBound::Skip);
+
+    if (preview.team.empty()) {
+        m_autoFillPreviewLabel->setText("No quick preview fits this budget. Searching...");
+    } else {
+        m_autoFillPreviewLabel->setText(
+            QString("Preview: %1. Searching for the exact team...")
+                .arg(describeAutoFillTeam(preview.team))
+        );
+    }
+
+    startExactPreviewSolve();
+}
+
+void TeamManagerView::showPreviewBound(int teamId, int64_t budget, const SelectionPreview& preview) {
+    if (!m_previewWatcher || m_previewPending || preview.team.empty() || !std::isfinite(preview.bound)) {
+        return;
+    }
+
+    if (!m_currentTeam || m_currentTeam->teamId != teamId || m_budgetInput->value() != budget) {
+        return;
+    }
+
+    m_autoFillPreviewLabel->setText(
+        QString("Preview: %1, within %2% of optimal. Searching for the exact team...")
+            .arg(describeAutoFillTeam(preview.team))
+            .arg(preview.gap * 100.0, 0, 'f', 1)
+    );
+}
+
+void TeamManagerView::startExactPreviewSolve() {
+    if (m_previewWatcher) {
+        m_previewStopSource.request_stop();
+        m_previewPending = true;
+        return;
+    }
+
+    const int teamId = m_currentTeam->teamId;
+    const int64_t budget = m_budgetInput->value();
+    m_previewStopSource = std::stop_source{};
+    m_previewPending = false;
+
+    SelectionOptions options;
+    options.timeLimitMs = AUTO_FILL_TIME_LIMIT_MS;
+    options.stopToken = m_previewStopSource.get_token();
+
+    m_previewWatcher = new QFutureWatcher<SelectionResult>(this);
+    connect(m_previewWatcher, &QFutureWatcher<SelectionResult>::finished, this, [this, teamId, budget]() {
+        finishExactPreviewSolve(teamId, budget);
+    });
+
+    m_previewWatcher->setFuture(QtConcurrent::run(
+        [this, teamId, positions = m_previewMissingPositions, budget, options = std::move(options)]() {
+            if (!options.stopToken.stop_requested()) {
+                SelectionPreview preview = m_teamManager.previewAutoFill(positions, budget);
+                QMetaObject::invokeMethod(this, [this, teamId, budget, preview = std::move(preview)]() {
+                    showPreviewBound(teamId, budget, preview);
+                }, Qt::QueuedConnection);
+            }
+
+            return m_teamManager.planAutoFill(positions, budget, options);
+        }));
+}
+
+void TeamManagerView::finishExactPreviewSolve(int teamId, int64_t budget) {
+    QFutureWatcher<SelectionResult>* watcher = std::exchange(m_previewWatcher, nullptr);
+    watcher->deleteLater();
+
+    if (m_previewPending) {
+        m_previewPending = false;
+        if (m_currentTeam && !m_previewMissingPositions.empty()) {
+            startExactPreviewSolve();
+        }
+        return;
+    }
+
+    if (!m_currentTeam || m_currentTeam->teamId != teamId || m_budgetInput->value() != budget) {
+        return;
+    }
+
+    SelectionResult result;
+    try {
+        result = watcher->result();
+    } catch (const std::exception& e) {
+        m_autoFillPreviewLabel->setText(QString("Preview failed: %1").arg(e.what()));
+        return;
+    }
+
+    if (result.status == SelectionStatus::Infeasible) {
+        m_autoFillPreviewLabel->setText("No team satisfies the budget and position requirements.");
+        return;
+    }
+
+    m_autoFillPreviewLabel->setText(
+        QString("%1: %2")
+            .arg(result.status == SelectionStatus::Optimal ? "Optimal" : "Best found")
+            .arg(describeAutoFillTeam(result.team))
+    );
+
+    if (result.status == SelectionStatus::Optimal) {
+        m_exactAutoFill = ExactAutoFill{teamId, budget, std::move(result)};
+    }
+}
+
+QString TeamManagerView::describeAutoFillTeam(std::span<const std::pair<int, Player>> team) const {
+    double totalRating = 0.0;
+    int64_t totalCost = 0;
+
+    for (const auto& [_, player] : team) {
+        totalRating += player.rating;
+        totalCost += player.marketValue;
+    }
+
+    return QString("%1 players, avg rating %2, cost €%3")
+        .arg(team.size())
+        .arg(team.empty() ? 0.0 : totalRating / static_cast<double>(team.size()), 0, 'f', 1)
+        .arg(QLocale().toString(static_cast<qlonglong>(totalCost)));
 }
 
 void TeamManagerView::navigateBack() {
@@ -6,7 +6,9 @@
 #include "utils/database/Database.h"
 #include "services/RatingManager.h"
 #include "services/TeamManager.h"
+#include "services/MaintenanceService.h"
 #include "utils/database/repositories/TeamRepository.h"
+#include "utils/database/repositories/ClubRepository.h"
 
 namespace {
 
@@ -26,18 +28,21 @@ namespace {
         auto ratingManager = std::make_unique<RatingManager>(database);
         auto teamRepository = std::make_unique<TeamRepository>(database);
         auto playerRepository = std::make_unique<PlayerRepository>(database);
+        auto clubRepository = std::make_unique<ClubRepository>(database);
         
         auto teamManager = std::make_unique<TeamManager>(
             *teamRepository,
             *ratingManager,
-            *playerRepository
+            *playerRepository,
+            *clubRepository
         );
         
         return std::tuple{
             std::move(ratingManager),
             std::move(teamManager),
             std::move(teamRepository),
-            std::move(playerRepository)
+            std::move(playerRepository),
+            std::move(clubRepository)
         };
     }
 
@@ -49,11 +54,14 @@ int main(int argc, char *argv[]) {
 
     Database database("main.db");
     
-    auto [ratingManager, teamManager, teamRepository, playerRepository] = 
+    auto [ratingManager, teamManager, teamRepository, playerRepository, clubRepository] = 
         initializeServices(database);
 
     MainWindow mainWindow(*ratingManager, *teamManager, database);
     mainWindow.show();
 
+    MaintenanceService maintenanceService(database);
+    maintenanceService.start();
+
     return app.exec();
 }
@@ -1,45 +1,150 @@
 #include "models/ILPSelector.h"
 #include <algorithm>
+#include <cmath>
+#include <exception>
+#include <optional>
+#include <functional>
 #include <limits>
+#include <queue>
+#include <random>
 #include <ranges>
 #include <stdexcept>
 #include <numeric>
+#include <unordered_map>
 
-ILPSelector::ILPSelector(std::span<const std::pair<int, Player>> players, 
+ILPSelector::ILPSelector(std::span<const std::pair<int, Player>> players,
                          std::span<const std::string> requiredPositions,
                          int64_t budget)
+    : ILPSelector(players, SquadRequirements::fromPositions(requiredPositions), budget) {
+}
+
+ILPSelector::ILPSelector(std::span<const std::pair<int, Player>> players,
+                         SquadRequirements requirements,
+                         int64_t budget)
     : m_players(players)
-    , m_requiredPositions(requiredPositions)
+    , m_requirements(std::move(requirements))
     , m_budget(budget) {
     if (budget < 0 || budget > std::numeric_limits<int64_t>::max() / 2) {
         throw std::invalid_argument("Budget value out of valid range");
     }
 }
 
-std::vector<ILPSelector::Variable> ILPSelector::createVariables() const {
+void ILPSelector::ConstraintMatrix::add(int row, int col, double value) {
+    rows.push_back(row);
+    cols.push_back(col);
+    values.push_back(value);
+}
+
+std::vector<ILPSelector::Variable> ILPSelector::createVariables(std::span<const double> ratingDeviations) const {
+    std::unordered_map<std::string_view, size_t> positionIndex;
+    positionIndex.reserve(m_requirements.quotas.size());
+
+    for (size_t j = 0; j < m_requirements.quotas.size(); j++) {
+        if (m_requirements.quotas[j].maxCount > 0) {
+            positionIndex.emplace(m_requirements.quotas[j].subPosition, j);
+        }
+    }
+
     std::vector<Variable> vars;
-    int varIdx = 1;
-    
+
     for (size_t i = 0; i < m_players.size(); i++) {
         const auto& [_, player] = m_players[i];
-        
-        for (size_t j = 0; j < m_requiredPositions.size(); j++) {
-            if (player.subPosition == m_requiredPositions[j]) {
-                vars.push_back({
-                    .playerIdx = i,
-                    .positionIdx = j,
-                    .varIdx = varIdx++,
-                    .rating = player.rating,
-                    .cost = static_cast<int64_t>(player.marketValue)
-                });
-            }
+
+        auto positionIt = positionIndex.find(player.subPosition);
+        if (positionIt == positionIndex.end() || m_requirements.excludedPlayerIds.contains(player.playerId)) {
+            continue;
         }
+
+        vars.push_back({
+            .playerIdx = i,
+            .positionIdx = positionIt->second,
+            .varIdx = 0,
+            .rating = player.rating,
+            .coefficient = player.rating,
+            .deviation = i < ratingDeviations.size() ? ratingDeviations[i] : 0.0,
+            .cost = static_cast<int64_t>(player.marketValue)
+        });
     }
-    
+
+    assignObjectiveCoefficients(vars);
+    vars = pruneDominatedVariables(std::move(vars), ratingDeviations.empty() ? 0.0 : ROBUST_PRUNE_DEVIATIONS);
+
+    int varIdx = 1;
+    for (auto& var : vars) {
+        var.varIdx = varIdx++;
+    }
+
     return vars;
 }
 
-void ILPSelector::addBudgetConstraint(glp_prob* lp, std::span<const Variable> vars) const {
+std::vector<ILPSelector::Variable> ILPSelector::pruneDominatedVariables(std::vector<Variable> vars, double deviationMargin) const {
+    std::vector<std::vector<size_t>> buckets(m_requirements.quotas.size());
+    for (size_t i = 0; i < vars.size(); i++) {
+        buckets[vars[i].positionIdx].push_back(i);
+    }
+
+    std::vector<bool> keep(vars.size(), false);
+
+    for (size_t pos = 0; pos < buckets.size(); pos++) {
+        auto& bucket = buckets[pos];
+        const auto maxCount = static_cast<size_t>(m_requirements.quotas[pos].maxCount);
+
+        std::ranges::sort(bucket, [&vars](size_t a, size_t b) {
+            if (vars[a].cost != vars[b].cost) {
+                return vars[a].cost < vars[b].cost;
+            }
+            return vars[a].coefficient > vars[b].coefficient;
+        });
+
+        std::priority_queue<double, std::vector<double>, std::greater<>> bestCoefficients;
+
+        for (size_t idx : bucket) {
+            const double margin = deviationMargin * vars[idx].deviation;
+            const double optimisticCoefficient = vars[idx].coefficient + margin;
+
+            if (bestCoefficients.size() >= maxCount && bestCoefficients.top() >= optimisticCoefficient) {
+                continue;
+            }
+
+            keep[idx] = true;
+            bestCoefficients.push(vars[idx].coefficient - margin);
+
+            if (bestCoefficients.size() > maxCount) {
+                bestCoefficients.pop();
+            }
+        }
+    }
+
+    std::vector<Variable> pruned;
+    pruned.reserve(vars.size());
+
+    for (size_t i = 0; i < vars.size(); i++) {
+        if (keep[i]) {
+            pruned.push_back(vars[i]);
+        }
+    }
+
+    return pruned;
+}
+
+void ILPSelector::assignObjectiveCoefficients(std::span<Variable> vars) const {
+    const double maxRating = std::transform_reduce(
+        vars.begin(), vars.end(),
+        0.0,
+        [](double a, double b) { return std::max(a, b); },
+        [](const Variable& var) { return var.rating; }
+    );
+
+    for (auto& var : vars) {
+        var.coefficient = var.rating;
+
+        if (var.cost <= 0) {
+            var.coefficient -= maxRating * 2;
+        }
+    }
+}
+
+void ILPSelector::addBudgetConstraint(glp_prob* lp, std::span<const Variable> vars, ConstraintMatrix& matrix) const {
     if (m_budget > std::numeric_limits<double>::max()) {
         throw std::overflow_error("Budget exceeds maximum double value");
     }
@@ -48,68 +153,70 @@ void ILPSelector::addBudgetConstraint(glp_prob* lp, std::span<const Variable> va
     glp_set_row_name(lp, rowIdx, "budget");
     glp_set_row_bnds(lp, rowIdx, GLP_UP, 0.0, static_cast<double>(m_budget));
 
-    std::vector<int> indices(vars.size() + 1);
-    std::vector<double> coeffs(vars.size() + 1);
-    
-    for (size_t i = 0; i < vars.size(); i++) {
-        indices[i + 1] = vars[i].varIdx;
-        
-        if (vars[i].cost > std::numeric_limits<double>::max()) {
+    for (const auto& var : vars) {
+        if (var.cost > std::numeric_limits<double>::max()) {
             throw std::overflow_error("Cost value exceeds maximum double value");
         }
-        
-        coeffs[i + 1] = static_cast<double>(vars[i].cost);
+
+        matrix.add(rowIdx, var.varIdx, static_cast<double>(var.cost));
     }
-    
-    glp_set_mat_row(lp, rowIdx, static_cast<int>(vars.size()), indices.data(), coeffs.data());
 }
 
-void ILPSelector::addPositionConstraints(glp_prob* lp, std::span<const Variable> vars) const {
-    for (size_t pos = 0; pos < m_requiredPositions.size(); pos++) {
-        auto posVars = vars | std::views::filter([pos](const Variable& var) {
-            return var.positionIdx == pos;
-        });
-        
-        std::vector<Variable> positionVars(posVars.begin(), posVars.end());
-        
-        if (positionVars.empty()) {
+void ILPSelector::addPositionConstraints(glp_prob* lp, std::span<const Variable> vars, ConstraintMatrix& matrix) const {
+    const auto& quotas = m_requirements.quotas;
+
+    std::vector<int> candidateCounts(quotas.size(), 0);
+    for (const auto& var : vars) {
+        candidateCounts[var.positionIdx]++;
+    }
+
+    std::vector<int> rowIndices(quotas.size(), 0);
+
+    for (size_t pos = 0; pos < quotas.size(); pos++) {
+        if (candidateCounts[pos] == 0) {
             continue;
         }
-        
+
+        const int maxCount = std::min(quotas[pos].maxCount, candidateCounts[pos]);
+        const int minCount = std::min(quotas[pos].minCount, maxCount);
+
         const int rowIdx = glp_add_rows(lp, 1);
         const std::string rowName = "pos_" + std::to_string(pos);
         glp_set_row_name(lp, rowIdx, rowName.c_str());
-        glp_set_row_bnds(lp, rowIdx, GLP_FX, 1.0, 1.0);
-        
-        std::vector<int> indices(positionVars.size() + 1);
-        std::vector<double> coeffs(positionVars.size() + 1);
-        
-        for (size_t i = 0; i < positionVars.size(); i++) {
-            indices[i + 1] = positionVars[i].varIdx;
-            coeffs[i + 1] = 1.0;
+
+        if (minCount == maxCount) {
+            glp_set_row_bnds(lp, rowIdx, GLP_FX, minCount, maxCount);
+        } else {
+            glp_set_row_bnds(lp, rowIdx, GLP_DB, minCount, maxCount);
         }
-        
-        glp_set_mat_row(lp, rowIdx, static_cast<int>(positionVars.size()), 
-                       indices.data(), coeffs.data());
+
+        rowIndices[pos] = rowIdx;
     }
-}
 
-void ILPSelector::setupObjectiveFunction(glp_prob* lp, std::span<const Variable> vars) const {
-    const double maxRating = std::transform_reduce(
-        vars.begin(), vars.end(),
-        0.0,
-        [](double a, double b) { return std::max(a, b); },
-        [](const Variable& var) { return var.rating; }
-    );
-    
     for (const auto& var : vars) {
-        double coefficient = var.rating;
+        matrix.add(rowIndices[var.positionIdx], var.varIdx, 1.0);
+    }
+}
 
-        if (var.cost <= 0) {
-            coefficient -= maxRating * 2;
-        }
+void ILPSelector::addSquadSizeConstraint(glp_prob* lp, std::span<const Variable> vars, ConstraintMatrix& matrix) const {
+    if (!m_requirements.squadSize || vars.empty()) {
+        return;
+    }
+
+    const int squadSize = std::min(*m_requirements.squadSize, static_cast<int>(vars.size()));
+
+    const int rowIdx = glp_add_rows(lp, 1);
+    glp_set_row_name(lp, rowIdx, "squad_size");
+    glp_set_row_bnds(lp, rowIdx, GLP_FX, squadSize, squadSize);
 
-        glp_set_obj_coef(lp, var.varIdx, coefficient);
+    for (const auto& var : vars) {
+        matrix.add(rowIdx, var.varIdx, 1.0);
+    }
+}
+
+void ILPSelector::setupObjectiveFunction(glp_prob* lp, std::span<const Variable> vars) const {
+    for (const auto& var : vars) {
+        glp_set_obj_coef(lp, var.varIdx, var.coefficient);
     }
 }
 
@@ -117,17 +224,17 @@ glp_prob* ILPSelector::createProblem() const {
     glp_prob* lp = glp_create_prob();
     glp_set_prob_name(lp, "team_selection");
     glp_set_obj_dir(lp, GLP_MAX);
-    
+
     return lp;
 }
 
 void ILPSelector::configureVariables(glp_prob* lp, std::span<const Variable> vars) const {
     glp_add_cols(lp, static_cast<int>(vars.size()));
-    
+
     for (const auto& var : vars) {
-        const std::string colName = "x_" + std::to_string(var.playerIdx) + "_" + 
+        const std::string colName = "x_" + std::to_string(var.playerIdx) + "_" +
                                    std::to_string(var.positionIdx);
-        
+
         glp_set_col_name(lp, var.varIdx, colName.c_str());
         glp_set_col_kind(lp, var.varIdx, GLP_BV);
         glp_set_col_bnds(lp, var.varIdx, GLP_DB, 0.0, 1.0);
@@ -135,47 +242,480 @@ void ILPSelector::configureVariables(glp_prob* lp, std::span<const Variable> var
 }
 
 std::vector<std::pair<int, Player>> ILPSelector::extractSolution(
-    glp_prob* lp, 
+    glp_prob* lp,
     std::span<const Variable> vars) const {
     std::vector<std::pair<int, Player>> result;
-    
+
     for (const auto& var : vars) {
         if (glp_mip_col_val(lp, var.varIdx) > 0.5) {
             result.push_back(m_players[var.playerIdx]);
         }
     }
-    
+
     return result;
 }
 
-std::vector<std::pair<int, Player>> ILPSelector::selectTeam() const {
+glp_prob* ILPSelector::buildProblem(std::span<const Variable> vars) const {
     glp_prob* lp = createProblem();
-    
+
     try {
-        const auto vars = createVariables();
         configureVariables(lp, vars);
-        
-        addBudgetConstraint(lp, vars);
-        addPositionConstraints(lp, vars);
+
+        ConstraintMatrix matrix;
+        matrix.rows.reserve(vars.size() * 3 + 1);
+        matrix.cols.reserve(vars.size() * 3 + 1);
+        matrix.values.reserve(vars.size() * 3 + 1);
+
+        addBudgetConstraint(lp, vars, matrix);
+        addPositionConstraints(lp, vars, matrix);
+        addSquadSizeConstraint(lp, vars, matrix);
+        glp_load_matrix(lp, matrix.size(), matrix.rows.data(), matrix.cols.data(), matrix.values.data());
+
         setupObjectiveFunction(lp, vars);
-        
+    }
+    catch (const std::exception&) {
+        glp_delete_prob(lp);
+        throw;
+    }
+
+    return lp;
+}
+
+void ILPSelector::solverCallback(glp_tree* tree, void* info) {
+    auto* context = static_cast<SolverContext*>(info);
+
+    // The bound keeps tightening between incumbents, so it is read on every call
+    // and the gap of an interrupted search reflects where the search stopped.
+    if (const int bestNode = glp_ios_best_node(tree); bestNode != 0) {
+        context->bestBound = glp_ios_node_bound(tree, bestNode);
+    }
+
+    if (context->options->stopToken.stop_requested()) {
+        glp_ios_terminate(tree);
+        return;
+    }
+
+    if (glp_ios_reason(tree) != GLP_IBINGO) {
+        return;
+    }
+
+    glp_prob* lp = glp_ios_get_prob(tree);
+
+    SelectionProgress progress;
+    progress.incumbentObjective = glp_mip_obj_val(lp);
+    progress.bestBound = std::isfinite(context->bestBound) ? context->bestBound : progress.incumbentObjective;
+    progress.gap = glp_ios_mip_gap(tree);
+    progress.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - context->startTime);
+
+    if (context->options->onProgress) {
+        context->options->onProgress(progress);
+    }
+}
+
+double ILPSelector::relativeGap(double objective, double bound) {
+    if (!std::isfinite(bound)) {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    // Same definition as glp_ios_mip_gap.
+    return std::abs(bound - objective) / (std::numeric_limits<double>::epsilon() + std::abs(objective));
+}
+
+std::vector<std::pair<int, Player>> ILPSelector::pruneCandidates(
+    std::span<const std::pair<int, Player>> players,
+    const SquadRequirements& requirements) {
+    ILPSelector selector(players, requirements, 0);
+    const auto vars = selector.createVariables();
+
+    std::vector<std::pair<int, Player>> candidates;
+    candidates.reserve(vars.size());
+
+    for (const auto& var : vars) {
+        candidates.push_back(players[var.playerIdx]);
+    }
+
+    return candidates;
+}
+
+bool ILPSelector::hasThreadLocalEnvironment() {
+    static const bool threadLocalEnvironment = glp_config("TLS") != nullptr;
+    return threadLocalEnvironment;
+}
+
+std::unique_lock<std::mutex> ILPSelector::lockSolverEnvironment() {
+    static std::mutex environmentMutex;
+
+    if (hasThreadLocalEnvironment()) {
+        return {};
+    }
+
+    return std::unique_lock<std::mutex>(environmentMutex);
+}
+
+SelectionResult ILPSelector::solve(const SelectionOptions& options) const {
+    SelectionResult result;
+
+    const auto vars = createVariables();
+    if (vars.empty() || options.stopToken.stop_requested()) {
+        result.status = vars.empty() ? SelectionStatus::Infeasible : SelectionStatus::Cancelled;
+        return result;
+    }
+
+    auto environmentLock = lockSolverEnvironment();
+    glp_prob* lp = buildProblem(vars);
+
+    SolverContext context{&options, std::chrono::steady_clock::now()};
+
+    glp_iocp parm;
+    glp_init_iocp(&parm);
+    parm.presolve = GLP_ON;
+    parm.msg_lev = GLP_MSG_OFF;
+    parm.tm_lim = options.timeLimitMs;
+    parm.cb_func = &ILPSelector::solverCallback;
+    parm.cb_info = &context;
+
+    const int err = glp_intopt(lp, &parm);
+    const int status = glp_mip_status(lp);
+    const bool hasSolution = status == GLP_OPT || status == GLP_FEAS;
+
+    if (err == 0 && status == GLP_OPT) {
+        result.status = SelectionStatus::Optimal;
+    } else if (err == GLP_ESTOP) {
+        result.status = SelectionStatus::Cancelled;
+    } else if (err == GLP_ETMLIM) {
+        result.status = SelectionStatus::TimeLimit;
+    } else {
+        result.status = SelectionStatus::Infeasible;
+    }
+
+    if (hasSolution && (err == 0 || err == GLP_ESTOP || err == GLP_ETMLIM)) {
+        result.team = extractSolution(lp, vars);
+        result.objective = glp_mip_obj_val(lp);
+        result.gap = result.status == SelectionStatus::Optimal
+            ? 0.0
+            : relativeGap(result.objective, context.bestBound);
+    }
+
+    result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - context.startTime);
+
+    glp_delete_prob(lp);
+    return result;
+}
+
+std::vector<size_t> ILPSelector::greedySelection(std::span<const Variable> vars) const {
+    const auto& quotas = m_requirements.quotas;
+
+    std::vector<std::vector<size_t>> buckets(quotas.size());
+    for (size_t i = 0; i < vars.size(); i++) {
+        buckets[vars[i].positionIdx].push_back(i);
+    }
+
+    std::vector<bool> selected(vars.size(), false);
+    std::vector<int> bucketCounts(quotas.size(), 0);
+    int64_t spent = 0;
+    int total = 0;
+
+    auto select = [&](size_t idx) {
+        selected[idx] = true;
+        bucketCounts[vars[idx].positionIdx]++;
+        spent += vars[idx].cost;
+        total++;
+    };
+
+    for (size_t pos = 0; pos < buckets.size(); pos++) {
+        auto& bucket = buckets[pos];
+        std::ranges::sort(bucket, {}, [&vars](size_t idx) { return vars[idx].cost; });
+
+        const size_t needed = std::min(static_cast<size_t>(quotas[pos].minCount), bucket.size());
+        for (size_t k = 0; k < needed; k++) {
+            select(bucket[k]);
+        }
+    }
+
+    if (spent > m_budget) {
+        return {};
+    }
+
+    if (m_requirements.squadSize) {
+        const int target = std::min(*m_requirements.squadSize, static_cast<int>(vars.size()));
+
+        while (total < target) {
+            std::optional<size_t> best;
+
+            for (size_t i = 0; i < vars.size(); i++) {
+                const auto& var = vars[i];
+                if (selected[i] || bucketCounts[var.positionIdx] >= quotas[var.positionIdx].maxCount ||
+                    spent + var.cost > m_budget) {
+                    continue;
+                }
+
+                if (!best || var.coefficient > vars[*best].coefficient) {
+                    best = i;
+                }
+            }
+
+            if (!best) {
+                break;
+            }
+
+            select(*best);
+        }
+    }
+
+    while (true) {
+        std::optional<std::pair<size_t, size_t>> bestSwap;
+        double bestRatio = 0.0;
+
+        for (const auto& bucket : buckets) {
+            for (size_t out : bucket) {
+                if (!selected[out]) {
+                    continue;
+                }
+
+                for (size_t in : bucket) {
+                    const double gain = vars[in].coefficient - vars[out].coefficient;
+                    const int64_t extraCost = vars[in].cost - vars[out].cost;
+
+                    if (selected[in] || gain <= 0.0 || spent + extraCost > m_budget) {
+                        continue;
+                    }
+
+                    const double ratio = extraCost <= 0
+                        ? std::numeric_limits<double>::infinity()
+                        : gain / static_cast<double>(extraCost);
+
+                    if (!bestSwap || ratio > bestRatio) {
+                        bestSwap = std::pair{out, in};
+                        bestRatio = ratio;
+                    }
+                }
+            }
+        }
+
+        if (!bestSwap) {
+            break;
+        }
+
+        selected[bestSwap->first] = false;
+        selected[bestSwap->second] = true;
+        spent += vars[bestSwap->second].cost - vars[bestSwap->first].cost;
+    }
+
+    std::vector<size_t> selection;
+    for (size_t i = 0; i < vars.size(); i++) {
+        if (selected[i]) {
+            selection.push_back(i);
+        }
+    }
+
+    return selection;
+}
+
+double ILPSelector::relaxationBound(std::span<const Variable> vars) const {
+    auto environmentLock = lockSolverEnvironment();
+    glp_prob* lp = buildProblem(vars);
+
+    glp_smcp parm;
+    glp_init_smcp(&parm);
+    parm.msg_lev = GLP_MSG_OFF;
+    parm.presolve = GLP_ON;
+
+    double bound = std::numeric_limits<double>::infinity();
+    if (glp_simplex(lp, &parm) == 0 && glp_get_status(lp) == GLP_OPT) {
+        bound = glp_get_obj_val(lp);
+    }
+
+    glp_delete_prob(lp);
+    return bound;
+}
+
+SelectionPreview ILPSelector::preview(PreviewBound bound) const {
+    SelectionPreview result;
+    const auto startTime = std::chrono::steady_clock::now();
+
+    const auto vars = createVariables();
+    const auto selection = greedySelection(vars);
+
+    for (size_t idx : selection) {
+        result.team.push_back(m_players[vars[idx].playerIdx]);
+        result.objective += vars[idx].coefficient;
+    }
+
+    if (!selection.empty() && bound == PreviewBound::Relaxation) {
+        result.bound = relaxationBound(vars);
+
+        if (std::isfinite(result.bound)) {
+            result.gap = std::max(0.0, result.bound - result.objective) /
+                         std::max(1e-9, std::abs(result.bound));
+        }
+    }
+
+    result.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startTime);
+
+    return result;
+}
+
+std::vector<std::vector<double>> ILPSelector::sampleScenarios(std::span<const Variable> vars,
+                                                               const RobustOptions& options) const {
+    std::vector<std::vector<double>> scenarios(static_cast<size_t>(options.scenarioCount));
+
+    #pragma omp parallel for
+    for (int s = 0; s < options.scenarioCount; s++) {
+        std::mt19937_64 generator(options.seed + static_cast<uint64_t>(s));
+        std::normal_distribution<double> noise(0.0, 1.0);
+
+        auto& coefficients = scenarios[static_cast<size_t>(s)];
+        coefficients.resize(vars.size());
+
+        for (size_t i = 0; i < vars.size(); i++) {
+            coefficients[i] = vars[i].coefficient + vars[i].deviation * noise(generator);
+        }
+    }
+
+    return scenarios;
+}
+
+std::vector<std::vector<int>> ILPSelector::solveScenarios(std::span<const Variable> vars,
+                                                          std::span<const std::vector<double>> scenarios,
+                                                          const RobustOptions& options) const {
+    std::vector<std::vector<int>> selections(scenarios.size());
+    std::exception_ptr failure;
+
+    // Without thread-local storage GLPK has one global environment, so the
+    // scenarios are solved one after another under a single lock. The lock is
+    // never held across the worksharing barrier below.
+    const bool parallel = hasThreadLocalEnvironment();
+    auto environmentLock = lockSolverEnvironment();
+
+    #pragma omp parallel if(parallel)
+    {
+        glp_prob* lp = nullptr;
+
+        try {
+            lp = buildProblem(vars);
+        } catch (...) {
+            #pragma omp critical(scenario_failure)
+            if (!failure) {
+                failure = std::current_exception();
+            }
+        }
+
         glp_iocp parm;
         glp_init_iocp(&parm);
         parm.presolve = GLP_ON;
         parm.msg_lev = GLP_MSG_OFF;
-        
-        const int err = glp_intopt(lp, &parm);
-        
-        std::vector<std::pair<int, Player>> result;
-        if (err == 0) {
-            result = extractSolution(lp, vars);
-        }
-        
-        glp_delete_prob(lp);
+        parm.tm_lim = options.scenarioTimeLimitMs;
+
+        #pragma omp for schedule(dynamic)
+        for (size_t s = 0; s < scenarios.size(); s++) {
+            if (!lp || options.stopToken.stop_requested()) {
+                continue;
+            }
+
+            for (const auto& var : vars) {
+                glp_set_obj_coef(lp, var.varIdx, scenarios[s][static_cast<size_t>(var.varIdx - 1)]);
+            }
+
+            const int err = glp_intopt(lp, &parm);
+            const int status = glp_mip_status(lp);
+
+            if ((err == 0 || err == GLP_ETMLIM) && (status == GLP_OPT || status == GLP_FEAS)) {
+                for (const auto& var : vars) {
+                    if (glp_mip_col_val(lp, var.varIdx) > 0.5) {
+                        selections[s].push_back(var.varIdx - 1);
+                    }
+                }
+            }
+        }
+
+        if (lp) {
+            glp_delete_prob(lp);
+        }
+    }
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    return selections;
+}
+
+RobustSelectionResult ILPSelector::solveRobust(std::span<const double> ratingDeviations,
+                                               const RobustOptions& options) const {
+    RobustSelectionResult result;
+    const auto startTime = std::chrono::steady_clock::now();
+
+    const auto vars = createVariables(ratingDeviations);
+    if (vars.empty() || options.scenarioCount <= 0) {
         return result;
     }
-    catch (const std::exception&) {
-        glp_delete_prob(lp);
-        throw;
+
+    const auto scenarios = sampleScenarios(vars, options);
+    auto selections = solveScenarios(vars, scenarios, options);
+
+    result.scenariosSolved = static_cast<int>(std::ranges::count_if(selections, [](const std::vector<int>& selection) {
+        return !selection.empty();
+    }));
+
+    std::ranges::sort(selections);
+    const auto [duplicatesBegin, duplicatesEnd] = std::ranges::unique(selections);
+    selections.erase(duplicatesBegin, duplicatesEnd);
+    std::erase_if(selections, [](const std::vector<int>& selection) { return selection.empty(); });
+
+    result.distinctTeams = static_cast<int>(selections.size());
+
+    const size_t decileCount = std::max<size_t>(1, scenarios.size() / 10);
+    double bestScore = -std::numeric_limits<double>::infinity();
+    const std::vector<int>* bestSelection = nullptr;
+
+    for (const auto& selection : selections) {
+        std::vector<double> scenarioRatings(scenarios.size());
+
+        for (size_t s = 0; s < scenarios.size(); s++) {
+            double total = 0.0;
+            for (int varPos : selection) {
+                total += scenarios[s][static_cast<size_t>(varPos)];
+            }
+            scenarioRatings[s] = total;
+        }
+
+        const double expected = std::reduce(scenarioRatings.begin(), scenarioRatings.end()) /
+                                static_cast<double>(scenarioRatings.size());
+
+        std::ranges::nth_element(scenarioRatings, scenarioRatings.begin() + static_cast<std::ptrdiff_t>(decileCount - 1));
+        const double worstDecile = scenarioRatings[decileCount - 1];
+
+        const double score = options.criterion == RobustCriterion::Expected ? expected : worstDecile;
+
+        if (score > bestScore) {
+            bestScore = score;
+            bestSelection = &selection;
+            result.expectedRating = expected;
+            result.worstDecileRating = worstDecile;
+        }
     }
+
+    if (bestSelection) {
+        for (int varPos : *bestSelection) {
+            result.selection.team.push_back(m_players[vars[static_cast<size_t>(varPos)].playerIdx]);
+        }
+
+        result.selection.objective = bestScore;
+        result.selection.gap = 0.0;
+        result.selection.status = options.stopToken.stop_requested()
+            ? SelectionStatus::Cancelled
+            : SelectionStatus::Optimal;
+    }
+
+    result.selection.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+
+    return result;
+}
+
+std::vector<std::pair<int, Player>> ILPSelector::selectTeam() const {
+    return solve({}).team;
 }
@@ -103,7 +103,7 @@ void PlayerRating::createRatingChangeRecord(
     change.matchImpact = matchImpact;
     change.goals = player.goals;
     change.assists = player.assists;
-    change.date = game.date;
+    change.date = formatDayNumber(game.day);
     
     ratingHistory[player.playerId].push_front(change);
     
@@ -182,7 +182,7 @@ std::vector<Game> PlayerRating::sortGamesByDate(std::span<const Game> games) con
     std::vector<Game> sortedGames(games.begin(), games.end());
     
     std::sort(sortedGames.begin(), sortedGames.end(), 
-        [](const Game& a, const Game& b) { return a.date < b.date; });
+        [](const Game& a, const Game& b) { return a.day < b.day; });
     
     return sortedGames;
 }
@@ -271,6 +271,43 @@ void PlayerRating::processMatchesParallel(
     }
 }
 
+void PlayerRating::processReplay(const ReplayColumns& replay) {
+    std::vector<PlayerAppearance> gameAppearances;
+    
+    for (size_t i = 0; i < replay.gameIds.size(); ++i) {
+        gameAppearances.clear();
+        
+        for (uint32_t a = replay.appearanceOffsets[i]; a < replay.appearanceOffsets[i + 1]; ++a) {
+            if (ratedPlayers.contains(replay.playerIds[a])) {
+                gameAppearances.push_back(PlayerAppearance{
+                    .playerId = replay.playerIds[a],
+                    .clubId = replay.clubIds[a],
+                    .gameId = replay.gameIds[i],
+                    .goals = replay.goals[a],
+                    .assists = replay.assists[a],
+                    .minutesPlayed = replay.minutesPlayed[a]
+                });
+            }
+        }
+        
+        if (gameAppearances.empty()) {
+            continue;
+        }
+        
+        Game game;
+        game.gameId = replay.gameIds[i];
+        game.homeClubId = replay.homeClubIds[i];
+        game.awayClubId = replay.awayClubIds[i];
+        game.homeGoals = replay.homeGoals[i];
+        game.awayGoals = replay.awayGoals[i];
+        game.homeClubName = replay.clubName(game.homeClubId);
+        game.awayClubName = replay.clubName(game.awayClubId);
+        game.day = replay.gameDays[i];
+        
+        processMatch(game, gameAppearances);
+    }
+}
+
 bool PlayerRating::sortPlayersByRating(const std::pair<int, Player>& a, const std::pair<int, Player>& b) {
     return a.second.rating > b.second.rating;
 }
@@ -300,3 +337,24 @@ std::vector<std::pair<int, Player>> PlayerRating::getSortedRatedPlayers() const
     std::sort(sortedPlayers.begin(), sortedPlayers.end(), sortPlayersByRating);
     return sortedPlayers;
 }
+
+const Player* PlayerRating::findRatedPlayer(int playerId) const {
+    const auto it = ratedPlayers.find(playerId);
+    return it != ratedPlayers.end() ? &it->second : nullptr;
+}
+
+double PlayerRating::getRatingDeviation(int playerId) const {
+    auto it = ratingHistory.find(playerId);
+    if (it == ratingHistory.end() || it->second.empty()) {
+        return MIN_RATING_DEVIATION;
+    }
+    
+    double squaredChanges = 0.0;
+    for (const auto& change : it->second) {
+        const double delta = change.newRating - change.previousRating;
+        squaredChanges += delta * delta;
+    }
+    
+    const double variance = squaredChanges / static_cast<double>(it->second.size());
+    return std::max(MIN_RATING_DEVIATION, std::sqrt(variance));
+}
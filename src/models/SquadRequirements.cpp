@@ -0,0 +1,163 @@
+#include "models/SquadRequirements.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <iostream>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+    using StartingCounts = std::vector<std::pair<std::string_view, int>>;
+
+    constexpr std::string_view GOALKEEPER = "Goalkeeper";
+
+    constexpr std::array<std::string_view, 13> SUB_POSITIONS = {
+        "Goalkeeper",
+        "Centre-Back", "Left-Back", "Right-Back",
+        "Defensive Midfield", "Central Midfield", "Attacking Midfield",
+        "Left Midfield", "Right Midfield",
+        "Left Winger", "Right Winger",
+        "Centre-Forward", "Second Striker"
+    };
+
+    void addStarting(StartingCounts& counts, std::string_view subPosition, int count) {
+        if (count > 0) {
+            counts.emplace_back(subPosition, count);
+        }
+    }
+
+    // Reads the outfield lines of a formation name such as "4-2-3-1", defence first.
+    std::optional<std::vector<int>> parseLines(std::string_view name) {
+        std::vector<int> lines;
+        int outfield = 0;
+
+        for (const auto part : std::views::split(name, '-')) {
+            const std::string_view digits(part.begin(), part.end());
+            int count = 0;
+            const auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), count);
+
+            if (error != std::errc{} || end != digits.data() + digits.size() || count <= 0) {
+                return std::nullopt;
+            }
+
+            lines.push_back(count);
+            outfield += count;
+        }
+
+        if (lines.size() < 2 || outfield != SquadRequirements::STARTING_PLAYERS - 1) {
+            return std::nullopt;
+        }
+
+        return lines;
+    }
+
+    // Spreads each line of the formation over the sub-positions that play in it:
+    // full-backs and wide midfielders flank lines of four or more, a front three
+    // uses wingers, and with two midfield lines the deeper one holds.
+    StartingCounts startingCounts(const std::vector<int>& lines) {
+        StartingCounts counts;
+        addStarting(counts, GOALKEEPER, 1);
+
+        const int defenders = lines.front();
+        const bool fullBacks = defenders >= 4;
+        addStarting(counts, "Left-Back", fullBacks ? 1 : 0);
+        addStarting(counts, "Centre-Back", fullBacks ? defenders - 2 : defenders);
+        addStarting(counts, "Right-Back", fullBacks ? 1 : 0);
+
+        const std::span midfield(lines.begin() + 1, lines.end() - 1);
+        if (midfield.size() == 1) {
+            const bool wide = midfield.front() >= 4;
+            addStarting(counts, "Left Midfield", wide ? 1 : 0);
+            addStarting(counts, "Central Midfield", wide ? midfield.front() - 2 : midfield.front());
+            addStarting(counts, "Right Midfield", wide ? 1 : 0);
+        } else if (!midfield.empty()) {
+            int holding = 0;
+            for (const int line : midfield.first(midfield.size() - 1)) {
+                holding += line;
+            }
+            addStarting(counts, "Defensive Midfield", holding);
+            addStarting(counts, "Attacking Midfield", midfield.back());
+        }
+
+        const int forwards = lines.back();
+        const bool wingers = forwards == 3;
+        addStarting(counts, "Left Winger", wingers ? 1 : 0);
+        addStarting(counts, "Centre-Forward", wingers ? 1 : forwards);
+        addStarting(counts, "Right Winger", wingers ? 1 : 0);
+
+        return counts;
+    }
+
+}
+
+SquadRequirements SquadRequirements::fromPositions(std::span<const std::string> positions) {
+    SquadRequirements requirements;
+    requirements.quotas.reserve(positions.size());
+
+    for (const auto& position : positions) {
+        requirements.quotas.push_back({position, 1, 1});
+    }
+
+    return requirements;
+}
+
+SquadRequirements SquadRequirements::fromFormation(const Formation& formation, int benchSize, int reserveSize) {
+    if (benchSize < 0 || reserveSize < 0) {
+        throw std::invalid_argument("Bench and reserve sizes must be non-negative");
+    }
+
+    const int squadSize = STARTING_PLAYERS + benchSize + reserveSize;
+    if (squadSize < MIN_SQUAD_SIZE || squadSize > MAX_SQUAD_SIZE) {
+        throw std::invalid_argument("Squad size must be between " + std::to_string(MIN_SQUAD_SIZE) +
+                                    " and " + std::to_string(MAX_SQUAD_SIZE));
+    }
+
+    StartingCounts counts;
+    if (const auto lines = parseLines(formation.name)) {
+        counts = startingCounts(*lines);
+    } else {
+        // Without a readable shape only the goalkeeper is fixed; the outfield is picked freely.
+        std::cerr << "Formation '" << formation.name << "' has no line layout, filling outfield without quotas" << std::endl;
+        addStarting(counts, GOALKEEPER, 1);
+    }
+
+    SquadRequirements requirements;
+    requirements.squadSize = squadSize;
+    requirements.quotas.reserve(SUB_POSITIONS.size());
+
+    for (const auto subPosition : SUB_POSITIONS) {
+        auto startingIt = std::ranges::find(counts, subPosition, &StartingCounts::value_type::first);
+        const int starting = startingIt != counts.end() ? startingIt->second : 0;
+
+        PositionQuota quota{std::string{subPosition}, starting, 0};
+
+        if (subPosition == GOALKEEPER) {
+            quota.minCount = starting + (benchSize > 0 ? 1 : 0);
+            quota.maxCount = quota.minCount + (reserveSize > 0 ? 1 : 0);
+        } else {
+            quota.maxCount = starting > 0 ? starting * 2 + 1 : 2;
+        }
+
+        requirements.quotas.push_back(std::move(quota));
+    }
+
+    return requirements;
+}
+
+void SquadRequirements::subtractExisting(std::span<const Player> players) {
+    for (const auto& player : players) {
+        excludedPlayerIds.insert(player.playerId);
+
+        auto quotaIt = std::ranges::find(quotas, player.subPosition.view(), &PositionQuota::subPosition);
+        if (quotaIt != quotas.end()) {
+            quotaIt->minCount = std::max(0, quotaIt->minCount - 1);
+            quotaIt->maxCount = std::max(0, quotaIt->maxCount - 1);
+        }
+    }
+
+    if (squadSize) {
+        squadSize = std::max(0, *squadSize - static_cast<int>(players.size()));
+    }
+}
@@ -0,0 +1,305 @@
+#include "services/MaintenanceService.h"
+#include "utils/database/Database.h"
+#include <array>
+#include <iostream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    constexpr std::array PROBE_QUERIES = {
+        "SELECT team_id, team_name FROM teams",
+        "SELECT team_id, player_id FROM team_players ORDER BY team_id",
+        "SELECT l.lineup_id, p.player_id FROM team_lineups l JOIN lineup_players p ON p.lineup_id = l.lineup_id",
+        "SELECT value FROM metadata WHERE key = 'last_updated'"
+    };
+
+    int64_t fileSize(const fs::path& path) {
+        std::error_code ec;
+        const auto size = fs::file_size(path, ec);
+        return ec ? 0 : static_cast<int64_t>(size);
+    }
+
+}
+
+MaintenanceService::MaintenanceService(Database& database)
+    : m_dbPath(database.getPath()) {
+    const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_FULLMUTEX;
+    if (sqlite3_open_v2(m_dbPath.string().c_str(), &m_db, flags, nullptr) != SQLITE_OK) {
+        std::cerr << "Can't open maintenance connection: " << sqlite3_errmsg(m_db) << std::endl;
+        sqlite3_close(m_db);
+        m_db = nullptr;
+        return;
+    }
+
+    sqlite3_busy_timeout(m_db, BUSY_TIMEOUT_MS);
+}
+
+MaintenanceService::~MaintenanceService() {
+    stop();
+
+    if (m_db) {
+        sqlite3_close(m_db);
+        m_db = nullptr;
+    }
+}
+
+void MaintenanceService::start() {
+    if (!m_db || m_worker.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = false;
+    }
+    m_worker = std::thread(&MaintenanceService::run, this);
+}
+
+void MaintenanceService::stop() {
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeUp.notify_all();
+
+    if (m_worker.joinable()) {
+        sqlite3_interrupt(m_db);
+        m_worker.join();
+    }
+}
+
+fs::path MaintenanceService::backupPath() const {
+    return m_dbPath.string() + ".bak";
+}
+
+std::optional<MaintenanceReport> MaintenanceService::lastReport() const {
+    std::lock_guard lock(m_mutex);
+    return m_lastReport;
+}
+
+void MaintenanceService::run() {
+    if (!waitFor(STARTUP_DELAY)) {
+        return;
+    }
+
+    int64_t lastVersion = dataVersion();
+    auto quietSince = std::chrono::steady_clock::now();
+    std::optional<std::chrono::steady_clock::time_point> lastPass;
+
+    while (waitFor(POLL_INTERVAL)) {
+        const auto now = std::chrono::steady_clock::now();
+        const int64_t version = dataVersion();
+
+        if (version != lastVersion) {
+            lastVersion = version;
+            quietSince = now;
+            continue;
+        }
+
+        const bool retryAllowed = !lastPass || now - *lastPass >= MAINTENANCE_INTERVAL;
+        if (now - quietSince >= IDLE_DELAY && retryAllowed && isDue()) {
+            runNow();
+            lastPass = now;
+            lastVersion = dataVersion();
+        }
+    }
+}
+
+bool MaintenanceService::waitFor(std::chrono::steady_clock::duration duration) {
+    std::unique_lock lock(m_mutex);
+    return !m_wakeUp.wait_for(lock, duration, [this] { return m_stopping; });
+}
+
+bool MaintenanceService::stopRequested() const {
+    std::lock_guard lock(m_mutex);
+    return m_stopping;
+}
+
+bool MaintenanceService::isDue() const {
+    std::error_code ec;
+    const auto lastBackup = fs::last_write_time(backupPath(), ec);
+    return ec || fs::file_time_type::clock::now() - lastBackup >= MAINTENANCE_INTERVAL;
+}
+
+int64_t MaintenanceService::dataVersion() const {
+    return pragmaValue("data_version");
+}
+
+MaintenanceReport MaintenanceService::runNow() {
+    std::lock_guard pass(m_passMutex);
+    MaintenanceReport report;
+
+    if (!m_db) {
+        return report;
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    report.fileSizeBefore = fileSize(m_dbPath);
+    report.probeLatencyBefore = probeLatency();
+    report.backedUp = backup();
+
+    const int64_t pageSize = pragmaValue("page_size");
+    const int64_t pagesBefore = pragmaValue("page_count");
+
+    if (enableIncrementalVacuum()) {
+        incrementalVacuum();
+    }
+    analyze();
+    execute("PRAGMA wal_checkpoint(TRUNCATE);");
+
+    report.reclaimedBytes = (pagesBefore - pragmaValue("page_count")) * pageSize;
+    report.fileSizeAfter = fileSize(m_dbPath);
+    report.probeLatencyAfter = probeLatency();
+    report.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+
+    std::cout << "Maintenance of " << m_dbPath << ": backup " << (report.backedUp ? "written" : "failed")
+              << ", reclaimed " << report.reclaimedBytes / 1024 << " KB"
+              << " (" << report.fileSizeBefore / 1024 << " KB -> " << report.fileSizeAfter / 1024 << " KB)"
+              << ", probe latency " << report.probeLatencyBefore.count() << " us -> "
+              << report.probeLatencyAfter.count() << " us in " << report.elapsed.count() << " ms" << std::endl;
+
+    std::lock_guard lock(m_mutex);
+    m_lastReport = report;
+    return report;
+}
+
+bool MaintenanceService::backup() {
+    const fs::path target = backupPath();
+    const fs::path tempPath = target.string() + ".tmp";
+    std::error_code ec;
+    fs::remove(tempPath, ec);
+
+    sqlite3* destination = nullptr;
+    if (sqlite3_open(tempPath.string().c_str(), &destination) != SQLITE_OK) {
+        std::cerr << "Can't open backup " << tempPath << ": " << sqlite3_errmsg(destination) << std::endl;
+        sqlite3_close(destination);
+        return false;
+    }
+
+    sqlite3_backup* backup = sqlite3_backup_init(destination, "main", m_db, "main");
+    if (!backup) {
+        std::cerr << "Failed to start backup: " << sqlite3_errmsg(destination) << std::endl;
+        sqlite3_close(destination);
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    // Copying a few pages at a time keeps the source lock short, so the GUI connection can keep writing.
+    int result = SQLITE_OK;
+    while (result == SQLITE_OK || result == SQLITE_BUSY || result == SQLITE_LOCKED) {
+        result = sqlite3_backup_step(backup, BACKUP_PAGES_PER_STEP);
+        if (result != SQLITE_DONE && !waitFor(STEP_PAUSE)) {
+            break;
+        }
+    }
+
+    sqlite3_backup_finish(backup);
+    sqlite3_close(destination);
+
+    if (result != SQLITE_DONE) {
+        if (!stopRequested()) {
+            std::cerr << "Backup of " << m_dbPath << " failed: " << sqlite3_errstr(result) << std::endl;
+        }
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    fs::rename(tempPath, target, ec);
+    if (ec) {
+        std::cerr << "Failed to replace backup " << target << ": " << ec.message() << std::endl;
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    return true;
+}
+
+bool MaintenanceService::enableIncrementalVacuum() {
+    constexpr int64_t INCREMENTAL = 2;
+    if (pragmaValue("auto_vacuum") == INCREMENTAL) {
+        return true;
+    }
+
+    // Switching modes needs one full VACUUM. The user database is small once the dataset lives elsewhere.
+    if (!execute("PRAGMA auto_vacuum=INCREMENTAL;") || !execute("VACUUM;")) {
+        return false;
+    }
+
+    std::cout << "Switched " << m_dbPath << " to incremental auto-vacuum" << std::endl;
+    return pragmaValue("auto_vacuum") == INCREMENTAL;
+}
+
+void MaintenanceService::incrementalVacuum() {
+    const std::string step = "PRAGMA incremental_vacuum(" + std::to_string(VACUUM_PAGES_PER_STEP) + ");";
+
+    while (pragmaValue("freelist_count") > 0) {
+        if (!execute(step.c_str()) || !waitFor(STEP_PAUSE)) {
+            return;
+        }
+    }
+}
+
+void MaintenanceService::analyze() {
+    const std::string limit = "PRAGMA analysis_limit=" + std::to_string(ANALYSIS_LIMIT) + ";";
+    if (execute(limit.c_str())) {
+        execute("ANALYZE;");
+    }
+}
+
+std::chrono::microseconds MaintenanceService::probeLatency() const {
+    std::vector<sqlite3_stmt*> statements;
+    for (const char* query : PROBE_QUERIES) {
+        sqlite3_stmt* stmt = nullptr;
+        if (sqlite3_prepare_v2(m_db, query, -1, &stmt, nullptr) == SQLITE_OK) {
+            statements.push_back(stmt);
+        } else {
+            sqlite3_finalize(stmt);
+        }
+    }
+
+    const auto runAll = [&statements] {
+        for (auto* stmt : statements) {
+            while (sqlite3_step(stmt) == SQLITE_ROW) {}
+            sqlite3_reset(stmt);
+        }
+    };
+
+    runAll();
+    const auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < PROBE_ITERATIONS; i++) {
+        runAll();
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - startTime;
+
+    for (auto* stmt : statements) {
+        sqlite3_finalize(stmt);
+    }
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed / PROBE_ITERATIONS);
+}
+
+int64_t MaintenanceService::pragmaValue(const char* pragma) const {
+    const std::string query = std::string("PRAGMA ") + pragma + ";";
+    sqlite3_stmt* stmt = nullptr;
+    int64_t value = 0;
+
+    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+        value = sqlite3_column_int64(stmt, 0);
+    }
+
+    sqlite3_finalize(stmt);
+    return value;
+}
+
+bool MaintenanceService::execute(const char* sql) const {
+    char* errMsg = nullptr;
+    if (sqlite3_exec(m_db, sql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "Maintenance error: " << errMsg << std::endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
+    return true;
+}
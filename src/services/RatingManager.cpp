@@ -3,11 +3,13 @@
 #include "utils/database/repositories/AppearanceRepository.h"
 #include "utils/database/repositories/PlayerRepository.h"
 #include "utils/database/Database.h"
+#include "utils/database/ReplayCache.h"
 #include "models/ILPSelector.h"
 
 #include <algorithm>
 #include <ranges>
 #include <unordered_set>
+#include <string_view>
 #include <execution>
 
 RatingManager::RatingManager(Database& database)
@@ -32,25 +34,55 @@ std::unique_ptr<PlayerRepository> RatingManager::createPlayerRepository() const
 }
 
 void RatingManager::loadAndProcessRatings() {
+    // Replays from scratch, so reloading after a dataset update doesn't count games twice.
+    m_ratingSystem = std::make_unique<PlayerRating>();
     initializePlayerRatings();
     processMatchData();
+    buildAutoFillCandidates();
 }
 
 void RatingManager::initializePlayerRatings() {
-    auto players = m_playerRepository->fetchPlayers();
-    
-    for (const auto& player : players) {
+    for (const auto& player : m_playerRepository->scanPlayers()) {
         m_ratingSystem->initializePlayer(player);
     }
 }
 
 void RatingManager::processMatchData() {
+    const auto cachePath = m_database.replayCachePath();
+    const auto datasetVersion = m_database.datasetVersion();
+    
+    auto cache = std::make_unique<ReplayCache>(cachePath, datasetVersion);
+    if (!cache->isOpen() && ReplayCache::write(m_database.getConnection(), cachePath, datasetVersion)) {
+        cache = std::make_unique<ReplayCache>(cachePath, datasetVersion);
+    }
+    
+    if (cache->isOpen()) {
+        m_ratingSystem->processReplay(cache->columns());
+        return;
+    }
+    
     auto games = m_gameRepository->fetchGames();
     auto appearances = m_appearanceRepository->fetchAppearances();
     
     m_ratingSystem->processMatchesParallel(games, appearances);
 }
 
+void RatingManager::buildAutoFillCandidates() {
+    auto sortedRatedPlayers = m_ratingSystem->getSortedRatedPlayers();
+
+    std::vector<std::string> subPositions;
+    std::unordered_set<std::string_view> seenSubPositions;
+    
+    for (const auto& [_, player] : sortedRatedPlayers) {
+        if (seenSubPositions.insert(player.subPosition).second) {
+            subPositions.push_back(player.subPosition);
+        }
+    }
+
+    m_autoFillCandidates = ILPSelector::pruneCandidates(
+        sortedRatedPlayers, SquadRequirements::fromPositions(subPositions));
+}
+
 std::vector<std::pair<int, Player>> RatingManager::selectOptimalTeamByPositions(
     std::span<const std::string> requiredPositions,
     int64_t budget) const 
@@ -61,25 +93,73 @@ std::vector<std::pair<int, Player>> RatingManager::selectOptimalTeamByPositions(
     return selector.selectTeam();
 }
 
-std::vector<Player> RatingManager::getFilteredRatedPlayers(
-    std::span<const Player> filterPlayers) const 
+SelectionResult RatingManager::selectOptimalTeamByPositions(
+    std::span<const std::string> requiredPositions,
+    int64_t budget,
+    const SelectionOptions& options) const 
 {
-    auto allRatedPlayers = m_ratingSystem->getSortedRatedPlayers();
+    ILPSelector selector(m_autoFillCandidates, requiredPositions, budget);
     
-    std::unordered_set<int> filterPlayerIds;
-    for (const auto& player : filterPlayers) {
-        filterPlayerIds.insert(player.playerId);
+    return selector.solve(options);
+}
+
+SelectionPreview RatingManager::previewTeamByPositions(
+    std::span<const std::string> requiredPositions,
+    int64_t budget,
+    PreviewBound bound) const 
+{
+    ILPSelector selector(m_autoFillCandidates, requiredPositions, budget);
+    
+    return selector.preview(bound);
+}
+
+RobustSelectionResult RatingManager::selectRobustTeamByPositions(
+    std::span<const std::string> requiredPositions,
+    int64_t budget,
+    const RobustOptions& options) const 
+{
+    auto sortedRatedPlayers = m_ratingSystem->getSortedRatedPlayers();
+    
+    std::vector<double> ratingDeviations;
+    ratingDeviations.reserve(sortedRatedPlayers.size());
+    
+    for (const auto& [id, _] : sortedRatedPlayers) {
+        ratingDeviations.push_back(m_ratingSystem->getRatingDeviation(id));
     }
     
+    ILPSelector selector(sortedRatedPlayers, requiredPositions, budget);
+    return selector.solveRobust(ratingDeviations, options);
+}
+
+std::vector<std::pair<int, Player>> RatingManager::selectOptimalSquad(
+    const SquadRequirements& requirements,
+    int64_t budget) const 
+{
+    auto sortedRatedPlayers = m_ratingSystem->getSortedRatedPlayers();
+    ILPSelector selector(sortedRatedPlayers, requirements, budget);
+    
+    return selector.selectTeam();
+}
+
+std::vector<Player> RatingManager::getFilteredRatedPlayers(
+    std::span<const Player> filterPlayers) const 
+{
+    std::unordered_set<int> seenPlayerIds;
     std::vector<Player> filteredPlayers;
-    filteredPlayers.reserve(filterPlayerIds.size());
+    filteredPlayers.reserve(filterPlayers.size());
     
-    for (const auto& [id, player] : allRatedPlayers) {
-        if (filterPlayerIds.contains(player.playerId)) {
-            filteredPlayers.push_back(player);
+    // Looking each player up by id keeps this proportional to the selection, not to every rated player.
+    for (const auto& player : filterPlayers) {
+        if (!seenPlayerIds.insert(player.playerId).second) {
+            continue;
+        }
+        
+        if (const Player* ratedPlayer = m_ratingSystem->findRatedPlayer(player.playerId)) {
+            filteredPlayers.push_back(*ratedPlayer);
         }
     }
     
+    std::ranges::sort(filteredPlayers, std::ranges::greater{}, &Player::rating);
     return filteredPlayers;
 }
 
@@ -5,10 +5,12 @@
 #include <iterator>
 #include <stdexcept>
 
-TeamManager::TeamManager(TeamRepository& teamRepo, RatingManager& ratingManager, PlayerRepository& playerRepo)
+TeamManager::TeamManager(TeamRepository& teamRepo, RatingManager& ratingManager, PlayerRepository& playerRepo,
+                         ClubRepository& clubRepo)
     : m_teamRepo(teamRepo)
     , m_ratingManager(ratingManager)
-    , m_playerRepo(playerRepo) 
+    , m_playerRepo(playerRepo)
+    , m_clubRepo(clubRepo)
 {}
 
 std::vector<std::string> TeamManager::getAvailableSubPositions() const {
@@ -142,14 +144,109 @@ void TeamManager::autoFillTeam(Team& team, int64_t budget) {
         return;
     }
 
-    auto selectedPlayers = m_ratingManager.selectOptimalTeamByPositions(
-        missingPositions, budget);
+    applyAutoFill(team, planAutoFill(missingPositions, budget, {}));
+}
+
+SelectionResult TeamManager::planAutoFill(std::span<const std::string> missingPositions, 
+                                          int64_t budget, 
+                                          const SelectionOptions& options) const {
+    return m_ratingManager.selectOptimalTeamByPositions(missingPositions, budget, options);
+}
+
+SelectionPreview TeamManager::previewAutoFill(std::span<const std::string> missingPositions, 
+                                             int64_t budget,
+                                             PreviewBound bound) const {
+    return m_ratingManager.previewTeamByPositions(missingPositions, budget, bound);
+}
+
+void TeamManager::applyAutoFill(Team& team, const SelectionResult& result) {
+    for (const auto& [_, player] : result.team) {
+        addPlayerToTeam(team.teamId, player);
+    }
+}
+
+void TeamManager::autoFillSquad(Team& team, const Formation& formation, int64_t budget, int benchSize, int reserveSize) {
+    auto requirements = SquadRequirements::fromFormation(formation, benchSize, reserveSize);
+    requirements.subtractExisting(team.players);
+    
+    if (requirements.squadSize.value_or(0) == 0) {
+        return;
+    }
+
+    auto selectedPlayers = m_ratingManager.selectOptimalSquad(requirements, budget);
     
     for (const auto& [_, player] : selectedPlayers) {
         addPlayerToTeam(team.teamId, player);
     }
 }
 
+std::vector<AutoFillOutcome> TeamManager::autoFillTeams(std::span<const int> teamIds, 
+                                                       const SelectionOptions& options) {
+    struct AutoFillJob {
+        Team* team;
+        std::vector<std::string> missingPositions;
+    };
+
+    const std::vector<std::string> availableSubPositions = getAvailableSubPositions();
+    const auto requiredPositions = buildRequiredPositionsMap(availableSubPositions);
+
+    std::vector<AutoFillJob> jobs;
+    jobs.reserve(teamIds.size());
+    
+    for (int teamId : teamIds) {
+        auto teamIt = m_teams.find(teamId);
+        if (teamIt == m_teams.end()) {
+            continue;
+        }
+        
+        auto positionMap = mapTeamPositions(teamIt->second, requiredPositions);
+        jobs.push_back({&teamIt->second, extractMissingPositions(positionMap)});
+    }
+
+    const auto candidatePool = m_ratingManager.getAutoFillCandidates();
+
+    std::vector<AutoFillOutcome> outcomes(jobs.size());
+    std::vector<SelectionResult> results(jobs.size());
+
+    #pragma omp parallel for schedule(dynamic)
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const auto start = std::chrono::steady_clock::now();
+        const AutoFillJob& job = jobs[i];
+
+        // An exception must not leave the parallel region, so a failing team only fails its own job.
+        try {
+            if (job.missingPositions.empty()) {
+                results[i].status = SelectionStatus::Optimal;
+                results[i].gap = 0.0;
+            } else {
+                ILPSelector selector(candidatePool, job.missingPositions, job.team->budget);
+                results[i] = selector.solve(options);
+            }
+        } catch (const std::exception& e) {
+            results[i] = SelectionResult{};
+            results[i].status = SelectionStatus::Failed;
+            outcomes[i].error = e.what();
+        }
+
+        outcomes[i].teamId = job.team->teamId;
+        outcomes[i].status = results[i].status;
+        outcomes[i].gap = results[i].gap;
+        outcomes[i].elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    }
+
+    for (size_t i = 0; i < jobs.size(); i++) {
+        applyAutoFill(*jobs[i].team, results[i]);
+        
+        outcomes[i].addedPlayers.reserve(results[i].team.size());
+        for (const auto& [_, player] : results[i].team) {
+            outcomes[i].addedPlayers.push_back(player);
+        }
+    }
+
+    return outcomes;
+}
+
 Team& TeamManager::loadTeam(int teamId) {
     auto it = m_teams.find(teamId);
     if (it == m_teams.end()) {
@@ -200,9 +297,7 @@ std::vector<std::pair<int, std::string>> TeamManager::getAllClubs() const {
     std::vector<std::pair<int, std::string>> clubs;
     std::unordered_map<int, std::string> uniqueClubs;
     
-    std::vector<Player> players = m_playerRepo.fetchPlayers();
-    
-    for (const auto& player : players) {
+    for (const auto& player : m_playerRepo.scanPlayers()) {
         if (player.clubId > 0 && !uniqueClubs.contains(player.clubId)) {
             uniqueClubs[player.clubId] = player.clubName;
         }
@@ -218,6 +313,14 @@ std::vector<std::pair<int, std::string>> TeamManager::getAllClubs() const {
     return clubs;
 }
 
+std::vector<int> TeamManager::searchPlayerIds(std::string_view text) const {
+    return m_playerRepo.searchPlayerIds(text);
+}
+
+std::vector<int> TeamManager::searchClubIds(std::string_view text) const {
+    return m_clubRepo.searchClubIds(text);
+}
+
 void TeamManager::saveTeam(const Team& team) {
     m_teamRepo.createTeam(team);
     for (const auto& player : team.players) {
@@ -235,24 +338,17 @@ void TeamManager::saveTeamPlayers(const Team& team) {
 void TeamManager::loadTeams() {
     m_teams.clear();
     std::vector<Team> loadedTeams = m_teamRepo.getAllTeams();
+    auto playersByTeam = m_playerRepo.fetchPlayersByAllTeams();
     
-    std::mutex teamsMutex;
-    
-    #pragma omp parallel for
-    for (size_t i = 0; i < loadedTeams.size(); i++) {
-        Team& team = loadedTeams[i];
-        int teamId = team.teamId;
-        
-        std::vector<Player> selection = m_playerRepo.fetchPlayers(-1, -1, teamId);
-        auto ratedPlayers = m_ratingManager.getFilteredRatedPlayers(selection);
+    for (Team& team : loadedTeams) {
+        const int teamId = team.teamId;
         
-        team.players = std::move(ratedPlayers);
-        
-        {
-            std::lock_guard<std::mutex> lock(teamsMutex);
-            m_teams[teamId] = std::move(team);
-            m_nextTeamId = std::max(m_nextTeamId, teamId);
+        if (const auto it = playersByTeam.find(teamId); it != playersByTeam.end()) {
+            team.players = m_ratingManager.getFilteredRatedPlayers(it->second);
         }
+        
+        m_teams[teamId] = std::move(team);
+        m_nextTeamId = std::max(m_nextTeamId, teamId);
     }
 }
 
@@ -0,0 +1,49 @@
+#include "utils/ByteStream.h"
+#include <algorithm>
+
+ByteStream::ByteStream(size_t capacityChunks)
+    : m_chunks(capacityChunks) {
+}
+
+bool ByteStream::write(std::string_view bytes) {
+    if (m_cancelled) {
+        return false;
+    }
+
+    return bytes.empty() || m_chunks.push(std::string(bytes));
+}
+
+void ByteStream::finish(bool success) {
+    if (!success) {
+        m_failed = true;
+    }
+    m_chunks.close();
+}
+
+void ByteStream::cancel() {
+    m_cancelled = true;
+    m_chunks.close();
+}
+
+size_t ByteStream::read(std::span<char> buffer) {
+    if (m_finished || buffer.empty()) {
+        return 0;
+    }
+
+    while (m_offset == m_current.size()) {
+        auto chunk = m_chunks.pop();
+        if (!chunk) {
+            m_finished = true;
+            return 0;
+        }
+
+        m_current = std::move(*chunk);
+        m_offset = 0;
+    }
+
+    const size_t copied = std::min(buffer.size(), m_current.size() - m_offset);
+    std::copy_n(m_current.data() + m_offset, copied, buffer.data());
+    m_offset += copied;
+
+    return copied;
+}
@@ -1,4 +1,6 @@
 #include "utils/KaggleAPI.h"
+#include "utils/ByteStream.h"
+#include "utils/database/ImportProgress.h"
 #include <iostream>
 #include <regex>
 #include <sstream>
@@ -6,8 +8,12 @@
 #include <array>
 #include <algorithm>
 #include <utility>
+#include <cstdlib>
 
-KaggleAPIClient::KaggleAPIClient() = default;
+KaggleAPIClient::KaggleAPIClient() 
+    : KaggleAPIClient("", "") 
+{
+}
 
 KaggleAPIClient::KaggleAPIClient(std::string_view username, std::string_view key) 
     : m_username(username)
@@ -16,6 +22,10 @@ KaggleAPIClient::KaggleAPIClient(std::string_view username, std::string_view key
     if (!m_username.empty() && !m_key.empty()) {
         m_authHeader = "Authorization: Basic " + base64Encode(m_username + ":" + m_key);
     }
+
+    if (const char* baseUrl = std::getenv(API_BASE_URL_ENV); baseUrl && *baseUrl) {
+        m_apiBaseUrl = baseUrl;
+    }
 }
 
 KaggleAPIClient::~KaggleAPIClient() = default;
@@ -24,6 +34,7 @@ KaggleAPIClient::KaggleAPIClient(KaggleAPIClient&& other) noexcept
     : m_username(std::move(other.m_username))
     , m_key(std::move(other.m_key))
     , m_authHeader(std::move(other.m_authHeader))
+    , m_apiBaseUrl(std::move(other.m_apiBaseUrl))
 {
 }
 
@@ -32,6 +43,7 @@ KaggleAPIClient& KaggleAPIClient::operator=(KaggleAPIClient&& other) noexcept {
         m_username = std::move(other.m_username);
         m_key = std::move(other.m_key);
         m_authHeader = std::move(other.m_authHeader);
+        m_apiBaseUrl = std::move(other.m_apiBaseUrl);
     }
     return *this;
 }
@@ -102,8 +114,30 @@ size_t KaggleAPIClient::writeMemoryCallback(void* contents, size_t size, size_t
     return realsize;
 }
 
-size_t KaggleAPIClient::writeDataCallback(void* ptr, size_t size, size_t nmemb, FILE* stream) {
-    return fwrite(ptr, size, nmemb, stream);
+size_t KaggleAPIClient::writeDataCallback(void* ptr, size_t size, size_t nmemb, DownloadTarget* target) {
+    const size_t written = fwrite(ptr, size, nmemb, target->file);
+
+    if (target->stream) {
+        target->stream->write({static_cast<const char*>(ptr), written * size});
+    }
+
+    return written;
+}
+
+int KaggleAPIClient::transferInfoCallback(void* clientp, curl_off_t downloadTotal, curl_off_t downloaded,
+                                          curl_off_t, curl_off_t) {
+    auto* progress = static_cast<ImportProgress*>(clientp);
+
+    if (downloadTotal > 0) {
+        progress->setExpectedBytes(ImportProgress::Stage::Download, static_cast<uint64_t>(downloadTotal));
+    }
+    progress->setProcessedBytes(ImportProgress::Stage::Download, static_cast<uint64_t>(downloaded));
+
+    return 0;
+}
+
+bool KaggleAPIClient::isLocalSource() const noexcept {
+    return m_apiBaseUrl.starts_with("file://");
 }
 
 std::unique_ptr<CURL, KaggleAPIClient::CurlDeleter> KaggleAPIClient::initCurl(std::string_view url) const {
@@ -143,6 +177,10 @@ bool KaggleAPIClient::executeRequest(CURL* curl, long& httpCode) const {
     CURLcode res = curl_easy_perform(curl);
     curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
     
+    if (res == CURLE_OK && httpCode == 0 && isLocalSource()) {
+        return true;
+    }
+    
     if (res != CURLE_OK || httpCode != 200) {
         std::cerr << "API request failed: " << curl_easy_strerror(res) 
                 << ", HTTP code: " << httpCode << std::endl;
@@ -245,7 +283,7 @@ time_t KaggleAPIClient::getDatasetLastUpdated(std::string_view dataset) const {
         return 0;
     }
     
-    std::string apiUrl = "https://www.kaggle.com/api/v1/datasets/list?search=" + std::string(dataset) + "&sortBy=updated";
+    std::string apiUrl = m_apiBaseUrl + "/datasets/list?search=" + std::string(dataset) + "&sortBy=updated";
     std::string response = makeApiRequest(apiUrl, true);
     
     if (response.empty()) {
@@ -269,13 +307,24 @@ time_t KaggleAPIClient::getDatasetLastUpdated(std::string_view dataset) const {
 
 bool KaggleAPIClient::setupDownloadRequest(
     CURL* curl,
-    FILE* fp,
+    DownloadTarget* target,
     curl_slist** headers
 ) const {
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeDataCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, target);
+    curl_easy_setopt(curl, CURLOPT_BUFFERSIZE, STREAM_BUFFER_SIZE);
     curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 30L);
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 600L);
+    // No total timeout: with a stream attached the write callback waits for the
+    // importer, so a slow import would abort a healthy download. Only a stalled
+    // connection is given up on.
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, LOW_SPEED_LIMIT_BYTES);
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, LOW_SPEED_TIME_SECONDS);
+
+    if (target->progress) {
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, transferInfoCallback);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, target->progress);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+    }
     
     if (!m_username.empty() && !m_key.empty()) {
         *headers = curl_slist_append(*headers, m_authHeader.c_str());
@@ -296,46 +345,43 @@ std::optional<FILE*> KaggleAPIClient::openOutputFile(std::string_view outputPath
     return fp;
 }
 
-bool KaggleAPIClient::downloadDataset(std::string_view dataset, std::string_view outputPath) const {
-    if (!validateCredentials(false)) {
-        return false;
-    }
-    
-    std::string apiUrl = "https://www.kaggle.com/api/v1/datasets/download/" + std::string(dataset);
-    
-    curl_global_init(CURL_GLOBAL_ALL);
-    auto curl = initCurl(apiUrl);
-
-    if (!curl) {
-        curl_global_cleanup();
-        return false;
-    }
-    
-    auto fpOpt = openOutputFile(outputPath);
-    if (!fpOpt) {
-        curl_global_cleanup();
-        return false;
-    }
-    
-    FILE* fp = *fpOpt;
-    curl_slist* rawHeaders = nullptr;
-    std::unique_ptr<curl_slist, CurlHeadersDeleter> headers(nullptr);
-    
-    if (!setupDownloadRequest(curl.get(), fp, &rawHeaders)) {
-        fclose(fp);
+bool KaggleAPIClient::downloadDataset(std::string_view dataset, 
+                                      std::string_view outputPath, 
+                                      ByteStream* stream,
+                                      ImportProgress* progress) const {
+    bool success = false;
+    
+    if (validateCredentials(false)) {
+        std::string apiUrl = m_apiBaseUrl + "/datasets/download/" + std::string(dataset);
+        
+        curl_global_init(CURL_GLOBAL_ALL);
+        auto curl = initCurl(apiUrl);
+        auto fpOpt = curl ? openOutputFile(outputPath) : std::nullopt;
+        
+        if (fpOpt) {
+            DownloadTarget target{*fpOpt, stream, progress};
+            curl_slist* rawHeaders = nullptr;
+            std::unique_ptr<curl_slist, CurlHeadersDeleter> headers(nullptr);
+            
+            if (setupDownloadRequest(curl.get(), &target, &rawHeaders)) {
+                headers.reset(rawHeaders);
+                
+                long httpCode = 0;
+                success = executeRequest(curl.get(), httpCode);
+                
+                if (!success) {
+                    std::cerr << "Failed to download dataset, HTTP code: " << httpCode << std::endl;
+                }
+            }
+            
+            success = fclose(target.file) == 0 && success;
+        }
+        
         curl_global_cleanup();
-        return false;
     }
-    headers.reset(rawHeaders);
     
-    long httpCode = 0;
-    bool success = executeRequest(curl.get(), httpCode);
-    
-    fclose(fp);
-    curl_global_cleanup();
-    
-    if (!success) {
-        std::cerr << "Failed to download dataset, HTTP code: " << httpCode << std::endl;
+    if (stream) {
+        stream->finish(success);
     }
     
     return success;
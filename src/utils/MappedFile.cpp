@@ -0,0 +1,145 @@
+#include "utils/MappedFile.h"
+#include <iostream>
+#include <utility>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+MappedFile::MappedFile(std::string_view path) {
+    const std::string filePath(path);
+
+#ifdef _WIN32
+    m_fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_fileHandle == INVALID_HANDLE_VALUE) {
+        m_fileHandle = nullptr;
+        std::cerr << "Failed to open file for mapping: " << path << std::endl;
+        return;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(m_fileHandle, &fileSize)) {
+        std::cerr << "Failed to get size of file: " << path << std::endl;
+        close();
+        return;
+    }
+
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    if (m_size == 0) {
+        m_open = true;
+        return;
+    }
+
+    m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mappingHandle) {
+        std::cerr << "Failed to create file mapping: " << path << std::endl;
+        close();
+        return;
+    }
+
+    m_data = static_cast<const char*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+#else
+    m_fd = ::open(filePath.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        std::cerr << "Failed to open file for mapping: " << path << std::endl;
+        return;
+    }
+
+    struct stat fileStat;
+    if (fstat(m_fd, &fileStat) != 0) {
+        std::cerr << "Failed to get size of file: " << path << std::endl;
+        close();
+        return;
+    }
+
+    m_size = static_cast<size_t>(fileStat.st_size);
+    if (m_size == 0) {
+        m_open = true;
+        return;
+    }
+
+    void* mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (mapping != MAP_FAILED) {
+        madvise(mapping, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(mapping);
+    }
+#endif
+
+    if (!m_data) {
+        std::cerr << "Failed to map file: " << path << std::endl;
+        close();
+        return;
+    }
+
+    m_open = true;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_open(std::exchange(other.m_open, false))
+#ifdef _WIN32
+    , m_fileHandle(std::exchange(other.m_fileHandle, nullptr))
+    , m_mappingHandle(std::exchange(other.m_mappingHandle, nullptr))
+#else
+    , m_fd(std::exchange(other.m_fd, -1))
+#endif
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_open = std::exchange(other.m_open, false);
+#ifdef _WIN32
+        m_fileHandle = std::exchange(other.m_fileHandle, nullptr);
+        m_mappingHandle = std::exchange(other.m_mappingHandle, nullptr);
+#else
+        m_fd = std::exchange(other.m_fd, -1);
+#endif
+    }
+    return *this;
+}
+
+void MappedFile::close() noexcept {
+#ifdef _WIN32
+    if (m_data) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mappingHandle) {
+        CloseHandle(m_mappingHandle);
+        m_mappingHandle = nullptr;
+    }
+    if (m_fileHandle) {
+        CloseHandle(m_fileHandle);
+        m_fileHandle = nullptr;
+    }
+#else
+    if (m_data) {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+    m_open = false;
+}
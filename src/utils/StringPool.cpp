@@ -0,0 +1,64 @@
+#include "utils/StringPool.h"
+#include <cstring>
+#include <mutex>
+
+StringPool& StringPool::global() {
+    static StringPool pool;
+    return pool;
+}
+
+std::string_view StringPool::intern(std::string_view text) {
+    if (text.empty()) {
+        return {EMPTY, 0};
+    }
+
+    {
+        std::shared_lock lock(m_mutex);
+        if (const auto it = m_strings.find(text); it != m_strings.end()) {
+            return *it;
+        }
+    }
+
+    std::unique_lock lock(m_mutex);
+    if (const auto it = m_strings.find(text); it != m_strings.end()) {
+        return *it;
+    }
+
+    char* copy = allocate(text.size() + 1);
+    std::memcpy(copy, text.data(), text.size());
+    copy[text.size()] = '\0';
+
+    const std::string_view pooled(copy, text.size());
+    m_strings.insert(pooled);
+    return pooled;
+}
+
+char* StringPool::allocate(size_t bytes) {
+    // Text longer than a block gets a block of its own and leaves the current one in use.
+    if (bytes > BLOCK_SIZE) {
+        m_blocks.push_back(std::make_unique<char[]>(bytes));
+        m_arenaBytes += bytes;
+        return m_blocks.back().get();
+    }
+
+    if (!m_block || m_blockUsed + bytes > BLOCK_SIZE) {
+        m_blocks.push_back(std::make_unique<char[]>(BLOCK_SIZE));
+        m_arenaBytes += BLOCK_SIZE;
+        m_block = m_blocks.back().get();
+        m_blockUsed = 0;
+    }
+
+    char* memory = m_block + m_blockUsed;
+    m_blockUsed += bytes;
+    return memory;
+}
+
+size_t StringPool::size() const {
+    std::shared_lock lock(m_mutex);
+    return m_strings.size();
+}
+
+size_t StringPool::arenaBytes() const {
+    std::shared_lock lock(m_mutex);
+    return m_arenaBytes;
+}
@@ -0,0 +1,518 @@
+#include "utils/ZipArchive.h"
+#include <iostream>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+    constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+    constexpr uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+    constexpr uint32_t END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+    constexpr uint32_t ZIP64_END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06064b50;
+    constexpr uint32_t ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+    constexpr uint32_t DATA_DESCRIPTOR_SIGNATURE = 0x08074b50;
+    constexpr uint16_t ZIP64_EXTRA_FIELD = 0x0001;
+
+    constexpr size_t LOCAL_HEADER_SIZE = 30;
+    constexpr size_t CENTRAL_HEADER_SIZE = 46;
+    constexpr size_t END_OF_CENTRAL_DIRECTORY_SIZE = 22;
+    constexpr size_t ZIP64_LOCATOR_SIZE = 20;
+    constexpr size_t MAX_COMMENT_SIZE = 0xFFFF;
+
+    constexpr uint16_t METHOD_STORED = 0;
+    constexpr uint16_t METHOD_DEFLATED = 8;
+    constexpr uint16_t FLAG_ENCRYPTED = 0x0001;
+    constexpr uint16_t FLAG_DATA_DESCRIPTOR = 0x0008;
+
+    uint16_t readU16(std::string_view data, size_t offset) {
+        const auto* bytes = reinterpret_cast<const unsigned char*>(data.data() + offset);
+        return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+    }
+
+    uint32_t readU32(std::string_view data, size_t offset) {
+        return readU16(data, offset) | (static_cast<uint32_t>(readU16(data, offset + 2)) << 16);
+    }
+
+    uint64_t readU64(std::string_view data, size_t offset) {
+        return readU32(data, offset) | (static_cast<uint64_t>(readU32(data, offset + 4)) << 32);
+    }
+
+    bool applyZip64Extra(std::string_view extra, ZipEntry& entry) {
+        size_t offset = 0;
+
+        while (offset + 4 <= extra.size()) {
+            const uint16_t headerId = readU16(extra, offset);
+            const uint16_t dataSize = readU16(extra, offset + 2);
+            const size_t dataStart = offset + 4;
+
+            if (dataStart + dataSize > extra.size()) {
+                return false;
+            }
+
+            if (headerId == ZIP64_EXTRA_FIELD) {
+                size_t fieldOffset = dataStart;
+                const size_t fieldEnd = dataStart + dataSize;
+
+                auto readIfSaturated = [&](uint64_t& value) {
+                    if (value == std::numeric_limits<uint32_t>::max() && fieldOffset + 8 <= fieldEnd) {
+                        value = readU64(extra, fieldOffset);
+                        fieldOffset += 8;
+                    }
+                };
+
+                readIfSaturated(entry.uncompressedSize);
+                readIfSaturated(entry.compressedSize);
+                readIfSaturated(entry.localHeaderOffset);
+                return true;
+            }
+
+            offset = dataStart + dataSize;
+        }
+
+        return false;
+    }
+
+}
+
+std::string_view zipFileName(std::string_view entryName) noexcept {
+    const auto slash = entryName.find_last_of('/');
+    return slash == std::string_view::npos ? entryName : entryName.substr(slash + 1);
+}
+
+ZipEntryReader::ZipEntryReader(const ZipEntry& entry, std::string_view compressedData)
+    : m_entry(entry)
+    , m_input(compressedData)
+    , m_crc(crc32(0L, Z_NULL, 0)) {
+    if (m_entry.flags & FLAG_ENCRYPTED) {
+        fail("encrypted entries are not supported");
+        return;
+    }
+
+    if (m_entry.method == METHOD_DEFLATED) {
+        if (inflateInit2(&m_stream, -MAX_WBITS) != Z_OK) {
+            fail("could not initialize inflater");
+            return;
+        }
+        m_inflating = true;
+    } else if (m_entry.method != METHOD_STORED) {
+        fail("unsupported compression method " + std::to_string(m_entry.method));
+    }
+}
+
+ZipEntryReader::~ZipEntryReader() {
+    if (m_inflating) {
+        inflateEnd(&m_stream);
+    }
+}
+
+size_t ZipEntryReader::read(std::span<char> buffer) {
+    if (m_failed || m_finished || buffer.empty()) {
+        return 0;
+    }
+
+    size_t produced = 0;
+
+    if (m_entry.method == METHOD_STORED) {
+        produced = std::min(buffer.size(), m_input.size() - m_inputOffset);
+        std::copy_n(m_input.data() + m_inputOffset, produced, buffer.data());
+        m_inputOffset += produced;
+
+        if (m_inputOffset == m_input.size()) {
+            m_finished = true;
+        }
+    } else {
+        const auto maxChunk = static_cast<size_t>(std::numeric_limits<uInt>::max());
+        m_stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+        m_stream.avail_out = static_cast<uInt>(std::min(buffer.size(), maxChunk));
+
+        while (m_stream.avail_out > 0) {
+            if (m_stream.avail_in == 0 && m_inputOffset < m_input.size()) {
+                const size_t chunk = std::min(m_input.size() - m_inputOffset, maxChunk);
+                m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(m_input.data() + m_inputOffset));
+                m_stream.avail_in = static_cast<uInt>(chunk);
+                m_inputOffset += chunk;
+            }
+
+            const int status = inflate(&m_stream, Z_NO_FLUSH);
+
+            if (status == Z_STREAM_END) {
+                m_finished = true;
+                break;
+            }
+
+            if (status != Z_OK) {
+                if (status == Z_BUF_ERROR && m_stream.avail_in == 0 && m_inputOffset == m_input.size()) {
+                    fail("truncated deflate stream");
+                } else if (status != Z_BUF_ERROR) {
+                    fail(m_stream.msg ? m_stream.msg : "inflate failed");
+                }
+                break;
+            }
+        }
+
+        produced = std::min(buffer.size(), maxChunk) - m_stream.avail_out;
+    }
+
+    m_crc = crc32(m_crc, reinterpret_cast<const Bytef*>(buffer.data()), static_cast<uInt>(produced));
+    m_bytesRead += produced;
+
+    if (m_finished) {
+        complete();
+    }
+
+    return produced;
+}
+
+void ZipEntryReader::complete() {
+    if (m_bytesRead != m_entry.uncompressedSize) {
+        fail("size mismatch");
+    } else if (m_crc != m_entry.crc32) {
+        fail("CRC-32 mismatch");
+    }
+}
+
+void ZipEntryReader::fail(std::string_view reason) {
+    m_failed = true;
+    std::cerr << "Failed to extract " << m_entry.name << ": " << reason << std::endl;
+}
+
+ZipArchive::ZipArchive(std::string_view path)
+    : m_file(path) {
+    m_open = m_file.isOpen() && readCentralDirectory();
+
+    if (m_file.isOpen() && !m_open) {
+        std::cerr << "Invalid or unsupported zip archive: " << path << std::endl;
+    }
+}
+
+bool ZipArchive::readCentralDirectory() {
+    const std::string_view data = m_file.view();
+    if (data.size() < END_OF_CENTRAL_DIRECTORY_SIZE) {
+        return false;
+    }
+
+    const size_t searchStart = data.size() > END_OF_CENTRAL_DIRECTORY_SIZE + MAX_COMMENT_SIZE
+        ? data.size() - END_OF_CENTRAL_DIRECTORY_SIZE - MAX_COMMENT_SIZE
+        : 0;
+
+    std::optional<size_t> eocdOffset;
+    for (size_t offset = data.size() - END_OF_CENTRAL_DIRECTORY_SIZE + 1; offset-- > searchStart;) {
+        if (readU32(data, offset) == END_OF_CENTRAL_DIRECTORY_SIGNATURE) {
+            eocdOffset = offset;
+            break;
+        }
+    }
+
+    if (!eocdOffset) {
+        return false;
+    }
+
+    uint64_t entryCount = readU16(data, *eocdOffset + 10);
+    uint64_t directorySize = readU32(data, *eocdOffset + 12);
+    uint64_t directoryOffset = readU32(data, *eocdOffset + 16);
+
+    if (*eocdOffset >= ZIP64_LOCATOR_SIZE && readU32(data, *eocdOffset - ZIP64_LOCATOR_SIZE) == ZIP64_LOCATOR_SIGNATURE) {
+        const uint64_t zip64Offset = readU64(data, *eocdOffset - ZIP64_LOCATOR_SIZE + 8);
+
+        if (zip64Offset + 56 <= data.size() && readU32(data, zip64Offset) == ZIP64_END_OF_CENTRAL_DIRECTORY_SIGNATURE) {
+            entryCount = readU64(data, zip64Offset + 32);
+            directorySize = readU64(data, zip64Offset + 40);
+            directoryOffset = readU64(data, zip64Offset + 48);
+        }
+    }
+
+    if (directoryOffset + directorySize > data.size()) {
+        return false;
+    }
+
+    size_t offset = directoryOffset;
+    m_entries.reserve(entryCount);
+
+    for (uint64_t i = 0; i < entryCount; i++) {
+        if (offset + CENTRAL_HEADER_SIZE > data.size() || readU32(data, offset) != CENTRAL_HEADER_SIGNATURE) {
+            return false;
+        }
+
+        const uint16_t nameLength = readU16(data, offset + 28);
+        const uint16_t extraLength = readU16(data, offset + 30);
+        const uint16_t commentLength = readU16(data, offset + 32);
+
+        if (offset + CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength > data.size()) {
+            return false;
+        }
+
+        ZipEntry entry;
+        entry.flags = readU16(data, offset + 8);
+        entry.method = readU16(data, offset + 10);
+        entry.crc32 = readU32(data, offset + 16);
+        entry.compressedSize = readU32(data, offset + 20);
+        entry.uncompressedSize = readU32(data, offset + 24);
+        entry.localHeaderOffset = readU32(data, offset + 42);
+        entry.name = data.substr(offset + CENTRAL_HEADER_SIZE, nameLength);
+
+        applyZip64Extra(data.substr(offset + CENTRAL_HEADER_SIZE + nameLength, extraLength), entry);
+
+        m_entries.push_back(std::move(entry));
+        offset += CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength;
+    }
+
+    return true;
+}
+
+const ZipEntry* ZipArchive::findEntry(std::string_view fileName) const {
+    auto entryIt = std::ranges::find_if(m_entries, [fileName](const ZipEntry& entry) {
+        return zipFileName(entry.name) == fileName;
+    });
+
+    return entryIt != m_entries.end() ? &*entryIt : nullptr;
+}
+
+std::optional<std::string_view> ZipArchive::entryData(const ZipEntry& entry) const {
+    const std::string_view data = m_file.view();
+
+    if (entry.localHeaderOffset + LOCAL_HEADER_SIZE > data.size() ||
+        readU32(data, entry.localHeaderOffset) != LOCAL_HEADER_SIGNATURE) {
+        return std::nullopt;
+    }
+
+    const uint64_t dataOffset = entry.localHeaderOffset + LOCAL_HEADER_SIZE +
+                                readU16(data, entry.localHeaderOffset + 26) +
+                                readU16(data, entry.localHeaderOffset + 28);
+
+    if (dataOffset + entry.compressedSize > data.size()) {
+        return std::nullopt;
+    }
+
+    return data.substr(dataOffset, entry.compressedSize);
+}
+
+ZipStreamReader::ZipStreamReader(ByteStream& archive, std::function<bool(std::string_view fileName)> wanted)
+    : m_archive(archive)
+    , m_wanted(std::move(wanted))
+    , m_entries(MAX_PENDING_ENTRIES) {
+    m_thread = std::thread([this]() { run(); });
+}
+
+ZipStreamReader::~ZipStreamReader() {
+    m_entries.close();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+std::optional<ZipStreamEntry> ZipStreamReader::nextEntry() {
+    return m_entries.pop();
+}
+
+void ZipStreamReader::run() {
+    bool reachedDirectory = false;
+
+    while (!reachedDirectory && !m_failed && fill(4)) {
+        const uint32_t signature = readU32(available(), 0);
+
+        if (signature == LOCAL_HEADER_SIGNATURE) {
+            m_failed = !readEntry();
+        } else if (signature == CENTRAL_HEADER_SIGNATURE || signature == END_OF_CENTRAL_DIRECTORY_SIGNATURE) {
+            reachedDirectory = true;
+        } else {
+            std::cerr << "Unexpected record in zip stream" << std::endl;
+            m_failed = true;
+        }
+    }
+
+    if (!reachedDirectory && !m_failed) {
+        std::cerr << "Zip stream ended before its central directory" << std::endl;
+        m_failed = true;
+    }
+
+    drainArchive();
+
+    if (m_archive.failed()) {
+        m_failed = true;
+    }
+
+    m_entries.close();
+}
+
+bool ZipStreamReader::readEntry() {
+    if (!fill(LOCAL_HEADER_SIZE)) {
+        return false;
+    }
+
+    const uint16_t nameLength = readU16(available(), 26);
+    const uint16_t extraLength = readU16(available(), 28);
+
+    if (!fill(LOCAL_HEADER_SIZE + nameLength + extraLength)) {
+        return false;
+    }
+
+    const std::string_view header = available();
+    ZipEntry entry;
+    entry.flags = readU16(header, 6);
+    entry.method = readU16(header, 8);
+    entry.crc32 = readU32(header, 14);
+    entry.compressedSize = readU32(header, 18);
+    entry.uncompressedSize = readU32(header, 22);
+    entry.name = header.substr(LOCAL_HEADER_SIZE, nameLength);
+
+    const bool zip64 = applyZip64Extra(header.substr(LOCAL_HEADER_SIZE + nameLength, extraLength), entry);
+    const bool hasDescriptor = entry.flags & FLAG_DATA_DESCRIPTOR;
+    consume(LOCAL_HEADER_SIZE + nameLength + extraLength);
+
+    if (entry.flags & FLAG_ENCRYPTED) {
+        std::cerr << "Failed to extract " << entry.name << ": encrypted entries are not supported" << std::endl;
+        return false;
+    }
+
+    if (entry.method != METHOD_DEFLATED && (entry.method != METHOD_STORED || hasDescriptor)) {
+        std::cerr << "Failed to extract " << entry.name << ": unsupported compression method " << entry.method << std::endl;
+        return false;
+    }
+
+    std::shared_ptr<ByteStream> sink;
+    if (!entry.name.ends_with('/') && m_wanted && m_wanted(zipFileName(entry.name))) {
+        sink = std::make_shared<ByteStream>(ENTRY_BUFFER_CHUNKS);
+
+        if (!m_entries.push({entry.name, sink, hasDescriptor ? 0 : entry.uncompressedSize})) {
+            sink.reset();
+        }
+    }
+
+    uLong crc = crc32(0L, Z_NULL, 0);
+    uint64_t size = 0;
+    bool ok = entry.method == METHOD_STORED
+        ? copyStored(entry, sink.get(), crc, size)
+        : inflateEntry(entry, sink.get(), crc, size);
+
+    if (ok && hasDescriptor) {
+        if (fill(4) && readU32(available(), 0) == DATA_DESCRIPTOR_SIGNATURE) {
+            consume(4);
+        }
+
+        const size_t sizeBytes = zip64 ? 8 : 4;
+        ok = fill(4 + 2 * sizeBytes);
+
+        if (ok) {
+            const std::string_view descriptor = available();
+            entry.crc32 = readU32(descriptor, 0);
+            entry.compressedSize = zip64 ? readU64(descriptor, 4) : readU32(descriptor, 4);
+            entry.uncompressedSize = zip64 ? readU64(descriptor, 12) : readU32(descriptor, 8);
+            consume(4 + 2 * sizeBytes);
+        }
+    }
+
+    if (!ok) {
+        std::cerr << "Failed to extract " << entry.name << ": truncated or corrupt data" << std::endl;
+    } else if (size != entry.uncompressedSize) {
+        std::cerr << "Failed to extract " << entry.name << ": size mismatch" << std::endl;
+        ok = false;
+    } else if (crc != entry.crc32) {
+        std::cerr << "Failed to extract " << entry.name << ": CRC-32 mismatch" << std::endl;
+        ok = false;
+    }
+
+    if (sink) {
+        sink->finish(ok);
+    }
+
+    return ok;
+}
+
+bool ZipStreamReader::copyStored(const ZipEntry& entry, ByteStream* sink, uLong& crc, uint64_t& size) {
+    uint64_t remaining = entry.compressedSize;
+
+    while (remaining > 0) {
+        if (!fill(1)) {
+            return false;
+        }
+
+        const std::string_view chunk = available().substr(0, std::min<uint64_t>(remaining, available().size()));
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(chunk.data()), static_cast<uInt>(chunk.size()));
+        size += chunk.size();
+
+        if (sink) {
+            sink->write(chunk);
+        }
+
+        consume(chunk.size());
+        remaining -= chunk.size();
+    }
+
+    return true;
+}
+
+bool ZipStreamReader::inflateEntry(const ZipEntry&, ByteStream* sink, uLong& crc, uint64_t& size) {
+    z_stream stream{};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        return false;
+    }
+
+    std::string output(INFLATE_CHUNK_SIZE, '\0');
+    int status = Z_OK;
+
+    while (status == Z_OK) {
+        if (!fill(1)) {
+            status = Z_DATA_ERROR;
+            break;
+        }
+
+        const std::string_view input = available();
+        const auto inputSize = static_cast<uInt>(std::min<size_t>(input.size(), std::numeric_limits<uInt>::max()));
+
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream.avail_in = inputSize;
+        stream.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream.avail_out = static_cast<uInt>(output.size());
+
+        status = inflate(&stream, Z_NO_FLUSH);
+        consume(inputSize - stream.avail_in);
+
+        const size_t produced = output.size() - stream.avail_out;
+        if (produced > 0) {
+            crc = crc32(crc, reinterpret_cast<const Bytef*>(output.data()), static_cast<uInt>(produced));
+            size += produced;
+
+            if (sink) {
+                sink->write({output.data(), produced});
+            }
+        }
+    }
+
+    inflateEnd(&stream);
+    return status == Z_STREAM_END;
+}
+
+bool ZipStreamReader::fill(size_t count) {
+    while (m_input.size() - m_inputOffset < count) {
+        if (m_inputOffset > 0) {
+            m_input.erase(0, m_inputOffset);
+            m_inputOffset = 0;
+        }
+
+        const size_t buffered = m_input.size();
+        m_input.resize(buffered + INFLATE_CHUNK_SIZE);
+        const size_t received = m_archive.read({m_input.data() + buffered, INFLATE_CHUNK_SIZE});
+        m_input.resize(buffered + received);
+
+        if (received == 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string_view ZipStreamReader::available() const noexcept {
+    return std::string_view(m_input).substr(m_inputOffset);
+}
+
+void ZipStreamReader::drainArchive() {
+    m_input.assign(INFLATE_CHUNK_SIZE, '\0');
+    m_inputOffset = 0;
+
+    while (m_archive.read(m_input) > 0) {
+    }
+
+    m_input.clear();
+}
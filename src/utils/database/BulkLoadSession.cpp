@@ -0,0 +1,133 @@
+#include "utils/database/BulkLoadSession.h"
+#include <iostream>
+#include <algorithm>
+
+BulkLoadSession::BulkLoadSession(sqlite3* db, std::span<const std::string> tableNames)
+    : m_db(db)
+    , m_startTime(std::chrono::steady_clock::now())
+    , m_loadedTime(m_startTime) {
+    saveAndApplyPragmas();
+    dropIndexes(tableNames);
+}
+
+BulkLoadSession::~BulkLoadSession() {
+    finish();
+}
+
+void BulkLoadSession::markLoaded() {
+    m_loadedTime = std::chrono::steady_clock::now();
+}
+
+void BulkLoadSession::finish() {
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+
+    if (m_loadedTime == m_startTime) {
+        markLoaded();
+    }
+
+    rebuildIndexes();
+    const auto indexedTime = std::chrono::steady_clock::now();
+
+    execute("ANALYZE;");
+    const auto analyzedTime = std::chrono::steady_clock::now();
+
+    restorePragmas();
+
+    auto elapsedMs = [](auto from, auto to) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(to - from).count();
+    };
+
+    std::cout << "Bulk load finished: load " << elapsedMs(m_startTime, m_loadedTime) << " ms, "
+              << m_deferredIndexes.size() << " index builds " << elapsedMs(m_loadedTime, indexedTime) << " ms, "
+              << "analyze " << elapsedMs(indexedTime, analyzedTime) << " ms, "
+              << "total " << elapsedMs(m_startTime, analyzedTime) << " ms" << std::endl;
+}
+
+void BulkLoadSession::saveAndApplyPragmas() {
+    m_savedPragmas = {
+        queryPragma("journal_mode"),
+        queryPragma("synchronous"),
+        queryPragma("cache_size"),
+        queryPragma("temp_store")
+    };
+
+    execute("PRAGMA journal_mode=MEMORY;");
+    execute("PRAGMA synchronous=OFF;");
+    execute("PRAGMA cache_size=-" + std::to_string(BULK_CACHE_SIZE_KIB) + ";");
+    execute("PRAGMA temp_store=MEMORY;");
+}
+
+void BulkLoadSession::restorePragmas() {
+    if (!m_savedPragmas.journalMode.empty()) {
+        execute("PRAGMA journal_mode=" + m_savedPragmas.journalMode + ";");
+    }
+    if (!m_savedPragmas.synchronous.empty()) {
+        execute("PRAGMA synchronous=" + m_savedPragmas.synchronous + ";");
+    }
+    if (!m_savedPragmas.cacheSize.empty()) {
+        execute("PRAGMA cache_size=" + m_savedPragmas.cacheSize + ";");
+    }
+    if (!m_savedPragmas.tempStore.empty()) {
+        execute("PRAGMA temp_store=" + m_savedPragmas.tempStore + ";");
+    }
+}
+
+void BulkLoadSession::dropIndexes(std::span<const std::string> tableNames) {
+    sqlite3_stmt* stmt = nullptr;
+    std::vector<std::string> indexNames;
+    const char* query = "SELECT name, tbl_name, sql FROM sqlite_master WHERE type='index' AND sql IS NOT NULL;";
+
+    if (sqlite3_prepare_v2(m_db, query, -1, &stmt, nullptr) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const auto* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+            const auto* table = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+            const auto* sql = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+
+            if (name && table && sql && std::ranges::find(tableNames, std::string_view(table)) != tableNames.end()) {
+                indexNames.emplace_back(name);
+                m_deferredIndexes.emplace_back(sql);
+            }
+        }
+    }
+
+    sqlite3_finalize(stmt);
+
+    for (const auto& indexName : indexNames) {
+        execute("DROP INDEX IF EXISTS \"" + indexName + "\";");
+    }
+}
+
+void BulkLoadSession::rebuildIndexes() {
+    for (const auto& indexSql : m_deferredIndexes) {
+        execute(indexSql + ";");
+    }
+}
+
+std::string BulkLoadSession::queryPragma(std::string_view pragma) const {
+    sqlite3_stmt* stmt = nullptr;
+    std::string value;
+    const std::string query = "PRAGMA " + std::string(pragma) + ";";
+
+    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            const auto* result = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+            value = result ? result : "";
+        }
+    }
+
+    sqlite3_finalize(stmt);
+    return value;
+}
+
+bool BulkLoadSession::execute(const std::string& sql) const {
+    char* errMsg = nullptr;
+    if (sqlite3_exec(m_db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "SQL error: " << errMsg << std::endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,314 @@
+#include "utils/database/CSVImporter.h"
+#include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <cctype>
+#include <cmath>
+#include <thread>
+
+CSVImporter::CSVImporter(sqlite3* db, size_t chunkSize)
+    : m_db(db)
+    , m_chunkSize(std::max<size_t>(chunkSize, 1)) {
+}
+
+void CSVRowBatch::appendRow(std::span<const std::string_view> rowFields, const CSVSource& source) {
+    const auto& inputChunk = source.inputChunk();
+    if (inputChunk && (inputChunks.empty() || inputChunks.back() != inputChunk)) {
+        inputChunks.push_back(inputChunk);
+    }
+
+    const std::string_view backingInput = source.stableInput();
+    const char* inputEnd = backingInput.data() + backingInput.size();
+
+    for (const auto field : rowFields) {
+        if (field.data() >= backingInput.data() && field.data() + field.size() <= inputEnd) {
+            fields.push_back(field);
+        } else {
+            fields.push_back(ownedFields.emplace_back(field));
+        }
+    }
+
+    rowCount++;
+}
+
+ImportStats CSVImporter::importFile(std::string_view tableName, std::string_view csvPath) {
+    return importSource({std::string(tableName), std::string(csvPath), {}});
+}
+
+ImportStats CSVImporter::importSource(const ImportSource& importSource) {
+    CSVSource source(importSource);
+    return importFrom(importSource.tableName, source);
+}
+
+ImportStats CSVImporter::importFrom(std::string_view tableName, CSVSource& source) {
+    const auto startTime = std::chrono::steady_clock::now();
+
+    if (!source.isOpen()) {
+        std::cerr << "Failed to open CSV file: " << source.label() << std::endl;
+        return {std::string(tableName), 0, 0, {}, true};
+    }
+
+    if (!source.nextRecord()) {
+        std::cerr << "Error: Could not extract columns from CSV file: " << source.label() << std::endl;
+        return {std::string(tableName), 0, 0, {}, true};
+    }
+
+    const std::vector<std::string> headers(source.fields().begin(), source.fields().end());
+
+    CSVRowQueue queue(QUEUE_CAPACITY);
+    size_t rowsSkipped = 0;
+
+    std::thread producer([&source, &queue, &rowsSkipped, fieldCount = headers.size()]() {
+        produceBatches(source, fieldCount, queue, rowsSkipped);
+    });
+
+    ImportStats stats = importBatches(tableName, headers, queue);
+    queue.close();
+    producer.join();
+
+    stats.rowsSkipped += rowsSkipped;
+    stats.failed = stats.failed || source.failed();
+    stats.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+
+    std::cout << "Imported " << stats.rowsImported << " rows from " << source.label() << " into " << tableName
+              << " in " << stats.elapsed.count() << " ms";
+    if (stats.rowsSkipped > 0) {
+        std::cout << " (" << stats.rowsSkipped << " rows skipped)";
+    }
+    std::cout << std::endl;
+
+    return stats;
+}
+
+void CSVImporter::produceBatches(CSVSource& source, size_t fieldCount, CSVRowQueue& queue, size_t& rowsSkipped) {
+    CSVRowBatch batch;
+    batch.fields.reserve(ROWS_PER_BATCH * fieldCount);
+
+    while (source.nextRecord()) {
+        const auto fields = source.fields();
+
+        if (fields.size() == 1 && trim(fields[0]).empty()) {
+            continue;
+        }
+
+        if (fields.size() != fieldCount) {
+            rowsSkipped++;
+            continue;
+        }
+
+        batch.appendRow(fields, source);
+
+        if (batch.rowCount == ROWS_PER_BATCH) {
+            if (!queue.push(std::move(batch))) {
+                return;
+            }
+
+            batch = CSVRowBatch{};
+            batch.fields.reserve(ROWS_PER_BATCH * fieldCount);
+        }
+    }
+
+    if (batch.rowCount > 0) {
+        queue.push(std::move(batch));
+    }
+
+    queue.close();
+}
+
+ImportStats CSVImporter::importBatches(std::string_view tableName,
+                                       std::span<const std::string> headers,
+                                       CSVRowQueue& queue) {
+    ImportStats stats;
+    stats.tableName = tableName;
+
+    std::string insertQuery;
+    const auto targetColumns = resolveTargetColumns(tableName, headers, insertQuery);
+
+    if (targetColumns.empty()) {
+        std::cerr << "Error: No CSV columns match table " << tableName << std::endl;
+        queue.close();
+        return stats;
+    }
+
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(m_db, insertQuery.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Failed to prepare import statement for " << tableName << ": " << sqlite3_errmsg(m_db) << std::endl;
+        queue.close();
+        return stats;
+    }
+
+    if (!execute("BEGIN TRANSACTION;")) {
+        sqlite3_finalize(stmt);
+        queue.close();
+        return stats;
+    }
+
+    size_t rowsInChunk = 0;
+    size_t rowIndex = 0;
+    bool failed = false;
+
+    while (!failed) {
+        auto batch = queue.pop();
+        if (!batch) {
+            break;
+        }
+
+        for (size_t row = 0; row < batch->rowCount; row++) {
+            const auto* rowFields = batch->fields.data() + row * headers.size();
+
+            for (size_t i = 0; i < targetColumns.size(); i++) {
+                const auto& column = targetColumns[i];
+                bindField(stmt, static_cast<int>(i) + 1, rowFields[column.fieldIndex], column.affinity);
+            }
+
+            if (sqlite3_step(stmt) == SQLITE_DONE) {
+                stats.rowsImported++;
+            } else {
+                stats.rowsSkipped++;
+                stats.rejectedRows.push_back(rowIndex);
+            }
+
+            rowIndex++;
+
+            sqlite3_reset(stmt);
+
+            if (++rowsInChunk == m_chunkSize) {
+                if (!execute("COMMIT;") || !execute("BEGIN TRANSACTION;")) {
+                    failed = true;
+                    break;
+                }
+                rowsInChunk = 0;
+            }
+        }
+    }
+
+    if (failed) {
+        queue.close();
+    }
+
+    execute("COMMIT;");
+    sqlite3_finalize(stmt);
+
+    return stats;
+}
+
+std::vector<std::pair<std::string, CSVImporter::ColumnAffinity>> CSVImporter::fetchTableColumns(std::string_view tableName) const {
+    std::vector<std::pair<std::string, ColumnAffinity>> columns;
+    const std::string query = "PRAGMA table_info(" + std::string(tableName) + ");";
+    sqlite3_stmt* stmt = nullptr;
+
+    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const auto* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+            const auto* type = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+
+            columns.emplace_back(name ? name : "", affinityFromDeclaredType(type ? type : ""));
+        }
+    }
+
+    sqlite3_finalize(stmt);
+    return columns;
+}
+
+std::vector<CSVImporter::TargetColumn> CSVImporter::resolveTargetColumns(std::string_view tableName,
+                                                                          std::span<const std::string> headers,
+                                                                          std::string& insertQuery) const {
+    const auto tableColumns = fetchTableColumns(tableName);
+
+    std::vector<TargetColumn> targetColumns;
+    std::string columnList;
+    std::string placeholders;
+
+    for (size_t i = 0; i < headers.size(); i++) {
+        const std::string_view header = trim(headers[i]);
+        auto columnIt = std::ranges::find(tableColumns, header, &std::pair<std::string, ColumnAffinity>::first);
+
+        if (columnIt == tableColumns.end()) {
+            std::cerr << "Warning: Ignoring unknown column " << header << " for table " << tableName << std::endl;
+            continue;
+        }
+
+        if (!targetColumns.empty()) {
+            columnList += ", ";
+            placeholders += ", ";
+        }
+
+        columnList += "\"" + columnIt->first + "\"";
+        placeholders += "?";
+        targetColumns.push_back({i, columnIt->second});
+    }
+
+    insertQuery = "INSERT OR REPLACE INTO " + std::string(tableName) + " (" + columnList + ") VALUES (" + placeholders + ");";
+    return targetColumns;
+}
+
+void CSVImporter::bindField(sqlite3_stmt* stmt, int index, std::string_view value, ColumnAffinity affinity) const {
+    value = trim(value);
+
+    if (value.empty()) {
+        sqlite3_bind_null(stmt, index);
+        return;
+    }
+
+    const char* first = value.data();
+    const char* last = value.data() + value.size();
+
+    if (affinity == ColumnAffinity::Integer || affinity == ColumnAffinity::Numeric) {
+        int64_t intValue = 0;
+        auto [ptr, ec] = std::from_chars(first, last, intValue);
+        if (ec == std::errc{} && ptr == last) {
+            sqlite3_bind_int64(stmt, index, intValue);
+            return;
+        }
+    }
+
+    if (affinity != ColumnAffinity::Text) {
+        double realValue = 0.0;
+        auto [ptr, ec] = std::from_chars(first, last, realValue);
+        // from_chars also reads "nan" and "inf", which the old import kept as text.
+        if (ec == std::errc{} && ptr == last && std::isfinite(realValue)) {
+            sqlite3_bind_double(stmt, index, realValue);
+            return;
+        }
+    }
+
+    sqlite3_bind_text(stmt, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+}
+
+bool CSVImporter::execute(const char* sql) const {
+    char* errMsg = nullptr;
+    if (sqlite3_exec(m_db, sql, nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "SQL error: " << errMsg << std::endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
+    return true;
+}
+
+CSVImporter::ColumnAffinity CSVImporter::affinityFromDeclaredType(std::string_view declaredType) {
+    std::string type(declaredType);
+    std::ranges::transform(type, type.begin(), [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+
+    if (type.find("INT") != std::string::npos) {
+        return ColumnAffinity::Integer;
+    }
+    if (type.find("CHAR") != std::string::npos || type.find("CLOB") != std::string::npos ||
+        type.find("TEXT") != std::string::npos) {
+        return ColumnAffinity::Text;
+    }
+    if (type.find("REAL") != std::string::npos || type.find("FLOA") != std::string::npos ||
+        type.find("DOUB") != std::string::npos) {
+        return ColumnAffinity::Real;
+    }
+    return ColumnAffinity::Numeric;
+}
+
+std::string_view CSVImporter::trim(std::string_view value) {
+    const auto startPos = value.find_first_not_of(" \t\n\r");
+    if (startPos == std::string_view::npos) {
+        return {};
+    }
+    const auto endPos = value.find_last_not_of(" \t\n\r");
+    return value.substr(startPos, endPos - startPos + 1);
+}
@@ -0,0 +1,137 @@
+#include "utils/database/CSVSource.h"
+#include "utils/database/ImportProgress.h"
+#include <iostream>
+#include <cstring>
+#include <filesystem>
+
+CSVSource::CSVSource(const ImportSource& source)
+    : m_label(source.archivePath.empty() ? source.csvPath : source.archivePath + ":" + source.csvPath) {
+    if (source.archivePath.empty()) {
+        m_file = std::make_unique<MappedFile>(source.csvPath);
+        m_open = m_file->isOpen();
+
+        if (m_open) {
+            m_tokenizer.reset(m_file->view());
+        }
+        return;
+    }
+
+    m_archive = std::make_unique<ZipArchive>(source.archivePath);
+    if (!m_archive->isOpen()) {
+        return;
+    }
+
+    const ZipEntry* entry = m_archive->findEntry(source.csvPath);
+    const auto compressedData = entry ? m_archive->entryData(*entry) : std::nullopt;
+
+    if (!compressedData) {
+        std::cerr << "Archive member not found or unreadable: " << m_label << std::endl;
+        return;
+    }
+
+    m_entryReader = std::make_unique<ZipEntryReader>(*entry, *compressedData);
+    m_open = !m_entryReader->failed();
+    m_tokenizer.reset({}, false);
+}
+
+CSVSource::CSVSource(std::string label, std::shared_ptr<ByteStream> stream)
+    : m_label(std::move(label))
+    , m_stream(std::move(stream))
+    , m_open(m_stream != nullptr) {
+    m_tokenizer.reset({}, false);
+}
+
+CSVSource::~CSVSource() {
+    reportProgress();
+
+    if (m_stream) {
+        m_stream->cancel();
+    }
+}
+
+bool CSVSource::failed() const noexcept {
+    return (m_entryReader && m_entryReader->failed()) || (m_stream && m_stream->failed());
+}
+
+bool CSVSource::streamFinished() const noexcept {
+    return m_entryReader ? m_entryReader->finished() : m_stream && m_stream->finished();
+}
+
+bool CSVSource::nextRecord() {
+    if (!m_open) {
+        return false;
+    }
+
+    while (!m_tokenizer.nextRecord()) {
+        if (!streaming() || streamFinished() || failed() || !refill()) {
+            reportProgress();
+            return false;
+        }
+    }
+
+    if (m_progress && ++m_rowsPending == PROGRESS_RECORD_INTERVAL) {
+        reportProgress();
+    }
+
+    return true;
+}
+
+void CSVSource::reportProgress() {
+    if (!m_progress) {
+        return;
+    }
+
+    const uint64_t consumed = streaming()
+        ? m_bytesRead - m_tokenizer.remaining().size()
+        : m_tokenizer.consumed();
+
+    if (consumed > m_bytesReported) {
+        m_progress->addProcessedBytes(ImportProgress::Stage::Parse, consumed - m_bytesReported);
+        m_bytesReported = consumed;
+    }
+
+    m_progress->addRows(m_rowsPending);
+    m_rowsPending = 0;
+}
+
+bool CSVSource::refill() {
+    // Batches may still point into the current chunk, so the next one is a new buffer
+    // that starts with the unfinished record carried over.
+    const std::string_view remaining = m_tokenizer.remaining();
+    const size_t carried = remaining.size();
+
+    auto chunk = std::make_shared<std::string>(carried + STREAM_CHUNK_SIZE, '\0');
+    std::memcpy(chunk->data(), remaining.data(), carried);
+
+    const std::span<char> target(chunk->data() + carried, STREAM_CHUNK_SIZE);
+    const size_t produced = m_entryReader ? m_entryReader->read(target) : m_stream->read(target);
+    chunk->resize(carried + produced);
+    m_bytesRead += produced;
+
+    if (failed()) {
+        return false;
+    }
+
+    m_chunk = std::move(chunk);
+    m_tokenizer.reset(*m_chunk, streamFinished());
+    return produced > 0 || streamFinished();
+}
+
+std::string_view CSVSource::stableInput() const noexcept {
+    if (m_file) {
+        return m_file->view();
+    }
+    return m_chunk ? std::string_view(*m_chunk) : std::string_view{};
+}
+
+uint64_t CSVSource::sourceSize(const ImportSource& source) {
+    if (source.archivePath.empty()) {
+        std::error_code sizeError;
+        const auto size = std::filesystem::file_size(source.csvPath, sizeError);
+        return sizeError ? 0 : size;
+    }
+
+    ZipArchive archive(source.archivePath);
+    const ZipEntry* entry = archive.isOpen() ? archive.findEntry(source.csvPath) : nullptr;
+    return entry ? entry->uncompressedSize : 0;
+}
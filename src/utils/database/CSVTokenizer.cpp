@@ -0,0 +1,160 @@
+#include "utils/database/CSVTokenizer.h"
+#include <bit>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define CSV_TOKENIZER_SSE2 1
+#endif
+
+CSVTokenizer::CSVTokenizer(std::string_view input, bool finalChunk) {
+    reset(input, finalChunk);
+}
+
+void CSVTokenizer::reset(std::string_view input, bool finalChunk) {
+    m_input = input;
+    m_position = 0;
+    m_finalChunk = finalChunk;
+    m_fields.clear();
+    m_unescapedCount = 0;
+}
+
+size_t CSVTokenizer::findSpecial(std::string_view input, size_t from, bool inQuotes) noexcept {
+    const char* data = input.data();
+    const size_t size = input.size();
+    size_t pos = from;
+
+#ifdef CSV_TOKENIZER_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    for (; pos + 16 <= size; pos += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        __m128i matches = _mm_cmpeq_epi8(block, quote);
+
+        if (!inQuotes) {
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, comma));
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, newline));
+        }
+
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+        if (mask != 0) {
+            return pos + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+#endif
+
+    for (; pos < size; pos++) {
+        const char c = data[pos];
+        if (c == '"' || (!inQuotes && (c == ',' || c == '\n'))) {
+            return pos;
+        }
+    }
+
+    return size;
+}
+
+bool CSVTokenizer::nextRecord() {
+    m_fields.clear();
+    m_unescapedCount = 0;
+
+    if (m_position >= m_input.size()) {
+        return false;
+    }
+
+    size_t pos = m_position;
+    size_t fieldStart = pos;
+    bool inQuotes = false;
+    bool quoted = false;
+    bool hasEscapes = false;
+
+    while (true) {
+        const size_t next = findSpecial(m_input, pos, inQuotes);
+
+        if (next >= m_input.size()) {
+            if (!m_finalChunk) {
+                m_fields.clear();
+                return false;
+            }
+
+            const size_t end = (m_input.size() > fieldStart && m_input.back() == '\r') ? m_input.size() - 1 : m_input.size();
+            emitField(fieldStart, end, quoted, hasEscapes);
+            m_position = m_input.size();
+            return true;
+        }
+
+        const char c = m_input[next];
+
+        if (inQuotes) {
+            if (next + 1 < m_input.size() && m_input[next + 1] == '"') {
+                hasEscapes = true;
+                pos = next + 2;
+            } else if (next + 1 == m_input.size() && !m_finalChunk) {
+                m_fields.clear();
+                return false;
+            } else {
+                inQuotes = false;
+                pos = next + 1;
+            }
+        } else if (c == '"') {
+            inQuotes = true;
+            quoted = true;
+            pos = next + 1;
+        } else if (c == ',') {
+            emitField(fieldStart, next, quoted, hasEscapes);
+            fieldStart = pos = next + 1;
+            quoted = hasEscapes = false;
+        } else {
+            const size_t end = (next > fieldStart && m_input[next - 1] == '\r') ? next - 1 : next;
+            emitField(fieldStart, end, quoted, hasEscapes);
+            m_position = next + 1;
+            return true;
+        }
+    }
+}
+
+void CSVTokenizer::emitField(size_t begin, size_t end, bool quoted, bool hasEscapes) {
+    std::string_view raw = m_input.substr(begin, end - begin);
+
+    if (!quoted) {
+        m_fields.push_back(raw);
+        return;
+    }
+
+    if (!hasEscapes) {
+        const auto first = raw.find('"');
+        const auto last = raw.rfind('"');
+
+        if (raw.find_first_not_of(" \t\r\n") == first && raw.find_last_not_of(" \t\r\n") == last && first != last) {
+            m_fields.push_back(raw.substr(first + 1, last - first - 1));
+            return;
+        }
+    }
+
+    m_fields.push_back(unescape(raw));
+}
+
+std::string_view CSVTokenizer::unescape(std::string_view raw) {
+    if (m_unescapedCount == m_unescaped.size()) {
+        m_unescaped.emplace_back();
+    }
+
+    std::string& buffer = m_unescaped[m_unescapedCount++];
+    buffer.clear();
+    buffer.reserve(raw.size());
+
+    bool inQuotes = false;
+    for (size_t i = 0; i < raw.size(); i++) {
+        if (raw[i] != '"') {
+            buffer += raw[i];
+        } else if (inQuotes && i + 1 < raw.size() && raw[i + 1] == '"') {
+            buffer += '"';
+            i++;
+        } else {
+            inQuotes = !inQuotes;
+        }
+    }
+
+    return buffer;
+}
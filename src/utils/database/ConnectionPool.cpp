@@ -0,0 +1,118 @@
+#include "utils/database/ConnectionPool.h"
+#include <algorithm>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+// The pools the current thread has a reader in. Its destructor runs when the
+// thread exits and closes those readers, so short-lived threads do not leave
+// connections behind.
+class ConnectionPool::ThreadReaders {
+public:
+    ThreadReaders() = default;
+    ~ThreadReaders() {
+        const auto threadId = std::this_thread::get_id();
+        for (const auto& pool : m_pools) {
+            if (const auto readers = pool.lock()) {
+                ConnectionPool::release(*readers, threadId);
+            }
+        }
+    }
+
+    ThreadReaders(const ThreadReaders&) = delete;
+    ThreadReaders& operator=(const ThreadReaders&) = delete;
+
+    void add(const std::shared_ptr<Readers>& readers) {
+        std::erase_if(m_pools, [](const auto& pool) { return pool.expired(); });
+        const bool known = std::ranges::any_of(m_pools, [&](const auto& pool) {
+            return !pool.owner_before(readers) && !readers.owner_before(pool);
+        });
+        if (!known) {
+            m_pools.push_back(readers);
+        }
+    }
+
+private:
+    std::vector<std::weak_ptr<Readers>> m_pools;
+};
+
+ConnectionPool::ConnectionPool(std::string dbPath, StatementCache& writer, OpenHook onOpen)
+    : m_dbPath(std::move(dbPath))
+    , m_writer(writer)
+    , m_onOpen(std::move(onOpen)) {
+}
+
+ConnectionPool::~ConnectionPool() {
+    closeReaders();
+}
+
+StatementCache& ConnectionPool::reader() {
+    const auto threadId = std::this_thread::get_id();
+    {
+        std::lock_guard lock(m_readers->mutex);
+        if (const auto it = m_readers->byThread.find(threadId); it != m_readers->byThread.end()) {
+            return *it->second.statements;
+        }
+    }
+
+    sqlite3* db = openReader();
+    if (!db) {
+        return m_writer;
+    }
+
+    Reader reader{db, std::make_unique<StatementCache>(db)};
+    StatementCache& statements = *reader.statements;
+
+    {
+        std::lock_guard lock(m_readers->mutex);
+        m_readers->byThread.emplace(threadId, std::move(reader));
+    }
+
+    static thread_local ThreadReaders threadReaders;
+    threadReaders.add(m_readers);
+    return statements;
+}
+
+sqlite3* ConnectionPool::openReader() const {
+    // Each reader stays on the thread that opened it, so SQLite's own connection mutex is not needed.
+    const int flags = SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX | SQLITE_OPEN_URI;
+    sqlite3* db = nullptr;
+
+    if (sqlite3_open_v2(m_dbPath.c_str(), &db, flags, nullptr) != SQLITE_OK) {
+        std::cerr << "Can't open read connection: " << sqlite3_errmsg(db) << std::endl;
+        sqlite3_close(db);
+        return nullptr;
+    }
+
+    if (m_onOpen) {
+        m_onOpen(db);
+    }
+    return db;
+}
+
+void ConnectionPool::closeReaders() {
+    std::lock_guard lock(m_readers->mutex);
+    for (auto& [threadId, reader] : m_readers->byThread) {
+        close(reader);
+    }
+    m_readers->byThread.clear();
+}
+
+size_t ConnectionPool::readerCount() const {
+    std::lock_guard lock(m_readers->mutex);
+    return m_readers->byThread.size();
+}
+
+void ConnectionPool::release(Readers& readers, std::thread::id threadId) {
+    std::lock_guard lock(readers.mutex);
+    if (const auto it = readers.byThread.find(threadId); it != readers.byThread.end()) {
+        close(it->second);
+        readers.byThread.erase(it);
+    }
+}
+
+void ConnectionPool::close(Reader& reader) {
+    reader.statements.reset();
+    sqlite3_close(reader.db);
+    reader.db = nullptr;
+}
@@ -1,5 +1,16 @@
 #include "utils/database/Database.h"
+#include "utils/database/ParallelImporter.h"
+#include "utils/database/BulkLoadSession.h"
+#include "utils/database/DeltaImporter.h"
+#include "utils/database/DatasetBuild.h"
+#include "utils/database/DatasetPatch.h"
+#include "utils/database/ReplayCache.h"
+#include "utils/database/TableRegistry.h"
+#include "utils/database/ImportProgress.h"
+#include "utils/database/QueryPlanAuditor.h"
 #include "utils/KaggleAPI.h"
+#include "utils/ZipArchive.h"
+#include "utils/ByteStream.h"
 #include <string>
 #include <iostream>
 #include <sstream>
@@ -9,12 +20,53 @@
 #include <sys/stat.h>
 #include <filesystem>
 #include <ctime>
-#include <cstdlib>
 #include <regex>
+#include <cctype>
+#include <optional>
+#include <ranges>
+#include <thread>
 #include <curl/curl.h>
 
 namespace fs = std::filesystem;
 
+namespace {
+
+    bool hasRows(sqlite3* db, std::string_view tableName) {
+        // max(rowid) is answered from the end of the table b-tree instead of a scan.
+        const std::string query = "SELECT max(rowid) IS NOT NULL FROM " + std::string(tableName) + ";";
+        sqlite3_stmt* stmt = nullptr;
+        bool hasData = false;
+
+        if (sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+            hasData = sqlite3_column_int(stmt, 0) > 0;
+        }
+
+        sqlite3_finalize(stmt);
+        return hasData;
+    }
+
+    std::string toFileUri(const fs::path& path) {
+        std::string uri = "file:";
+        if (path.has_root_name()) {
+            uri += '/';
+        }
+
+        for (const unsigned char c : path.generic_string()) {
+            if (std::isalnum(c) || std::string_view("/-._~:").find(static_cast<char>(c)) != std::string_view::npos) {
+                uri += static_cast<char>(c);
+            } else {
+                constexpr const char* hexDigits = "0123456789ABCDEF";
+                uri += '%';
+                uri += hexDigits[c >> 4];
+                uri += hexDigits[c & 0x0F];
+            }
+        }
+
+        return uri;
+    }
+
+}
+
 size_t Database::WriteDataCallback(void* ptr, size_t size, size_t nmemb, FILE* stream) {
     return fwrite(ptr, size, nmemb, stream);
 }
@@ -23,12 +75,37 @@ Database::Database(std::string_view dbPath)
     : m_dbPath(dbPath) {
     m_newDatabase = !fileExists(dbPath);
     
-    if (sqlite3_open(m_dbPath.c_str(), &m_db) != SQLITE_OK) {
+    const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_URI;
+    const int openResult = sqlite3_open_v2(m_dbPath.c_str(), &m_db, flags, nullptr);
+    m_statementCache = std::make_unique<StatementCache>(m_db);
+    m_connections = std::make_unique<ConnectionPool>(m_dbPath, *m_statementCache,
+                                                     [this](sqlite3* db) { prepareReader(db); });
+
+    if (openResult != SQLITE_OK) {
         std::cerr << "Can't open database: " << sqlite3_errmsg(m_db) << std::endl;
+        return;
+    }
+
+    sqlite3_exec(m_db, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr);
+    sqlite3_busy_timeout(m_db, BUSY_TIMEOUT_MS);
+
+    if (QueryPlanAuditor::isEnabled()) {
+        m_queryAuditor = std::make_unique<QueryPlanAuditor>(m_db);
     }
 }
 
 Database::~Database() {
+    m_connections.reset();
+
+    if (m_queryAuditor) {
+        m_queryAuditor->printReport();
+        m_queryAuditor.reset();
+
+        const auto stats = m_statementCache->stats();
+        std::cout << "Statement cache: " << stats.hits << " hits, " << stats.misses << " misses" << std::endl;
+    }
+    m_statementCache.reset();
+
     if (m_db) {
         sqlite3_close(m_db);
         m_db = nullptr;
@@ -49,49 +126,47 @@ bool Database::fileExists(std::string_view filePath) const {
 }
 
 void Database::initialize(ProgressCallback progressCallback) {
+    if (tableExists("players")) {
+        if (progressCallback) {
+            progressCallback("Moving dataset into its own file", 12);
+        }
+        migrateLegacyDataset();
+    }
+
+    attachDataset();
     m_newDatabase = !fileExists(m_dbPath) || !isDatabaseInitialized();
     
     if (m_newDatabase) {
         if (progressCallback) {
             progressCallback("Creating database schema", 15);
         }
-        executeSQLFile("../db/data.sql");
-        executeSQLFile("../db/user.sql");
-        loadDataIntoDatabase(false, progressCallback);
+        executeSQLFile(USER_SCHEMA_PATH);
+        loadDataIntoDatabase(progressCallback);
     } else {
         if (progressCallback) {
-            progressCallback("Checking for dataset updates", 15);
+            progressCallback("Opening dataset", 15);
         }
-        updateDatasetIfNeeded(progressCallback);
+        ensureCompactSchema();
     }
+
+    executeSQLFile(USER_INDEXES_PATH);
 }
 
 bool Database::isDatabaseInitialized() const {
-    const std::vector<std::string> requiredTables = {
-        "appearances", "club_games", "clubs", "competitions",
-        "game_events", "game_lineups", "games", "player_valuations",
-        "players", "transfers", "metadata"
-    };
-    
-    for (const auto& table : requiredTables) {
-        if (!tableExists(table)) {
-            return false;
-        }
-        
-        if (table != "metadata" && !tableHasData(table)) {
+    for (const auto& table : TableRegistry::requiredTables()) {
+        if (!tableExists(table, DATASET_SCHEMA) || !tableHasData(table)) {
             return false;
         }
     }
     
-    return metadataHasEntry("last_updated");
+    return tableExists("metadata") && metadataHasEntry("last_updated");
 }
 
-bool Database::tableExists(std::string_view tableName) const {
-    sqlite3_stmt* stmt = nullptr;
+bool Database::tableExists(std::string_view tableName, std::string_view schema) const {
     bool exists = false;
-    const std::string query = "SELECT name FROM sqlite_master WHERE type='table' AND name=?;";
+    const std::string query = "SELECT name FROM " + std::string(schema) + ".sqlite_master WHERE type='table' AND name=?;";
     
-    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+    if (auto stmt = m_statementCache->acquire(query)) {
         sqlite3_bind_text(stmt, 1, tableName.data(), static_cast<int>(tableName.size()), SQLITE_TRANSIENT);
         
         if (sqlite3_step(stmt) == SQLITE_ROW) {
@@ -99,7 +174,6 @@ bool Database::tableExists(std::string_view tableName) const {
         }
     }
     
-    sqlite3_finalize(stmt);
     return exists;
 }
 
@@ -108,18 +182,7 @@ bool Database::tableHasData(std::string_view tableName) const {
         return true;
     }
     
-    std::string query = "SELECT COUNT(*) FROM " + std::string(tableName) + ";";
-    sqlite3_stmt* stmt = nullptr;
-    bool hasData = false;
-    
-    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
-        if (sqlite3_step(stmt) == SQLITE_ROW) {
-            hasData = (sqlite3_column_int(stmt, 0) > 0);
-        }
-    }
-    
-    sqlite3_finalize(stmt);
-    return hasData;
+    return hasRows(m_db, tableName);
 }
 
 bool Database::metadataHasEntry(std::string_view key) const {
@@ -130,273 +193,543 @@ bool Database::isNewDatabase() const {
     return m_newDatabase;
 }
 
-void Database::executeSQLFile(std::string_view filePath) {
+fs::path Database::datasetPath() const {
+    return fs::path(m_dbPath).parent_path() / DATASET_FILE_NAME;
+}
+
+fs::path Database::replayCachePath() const {
+    return fs::path(m_dbPath).parent_path() / REPLAY_CACHE_FILE_NAME;
+}
+
+int64_t Database::datasetVersion() const {
+    return static_cast<int64_t>(getLastUpdateTimestamp());
+}
+
+bool Database::attachDataset() {
+    if (m_datasetAttached || !fileExists(datasetPath().string())) {
+        return m_datasetAttached;
+    }
+
+    m_datasetAttached = attachDatasetTo(m_db);
+    return m_datasetAttached;
+}
+
+bool Database::attachDatasetTo(sqlite3* db) const {
+    sqlite3_stmt* stmt = nullptr;
+    bool attached = false;
+    const std::string query = "ATTACH DATABASE ? AS " + std::string(DATASET_SCHEMA) + ";";
+
+    if (sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        const std::string uri = toFileUri(datasetPath()) + "?mode=ro&immutable=1";
+        sqlite3_bind_text(stmt, 1, uri.c_str(), -1, SQLITE_TRANSIENT);
+        attached = sqlite3_step(stmt) == SQLITE_DONE;
+    }
+    sqlite3_finalize(stmt);
+
+    if (!attached) {
+        std::cerr << "Failed to attach dataset " << datasetPath() << ": " << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+
+    const std::string mmap = "PRAGMA " + std::string(DATASET_SCHEMA) + ".mmap_size=" + std::to_string(DATASET_MMAP_SIZE) + ";";
+    sqlite3_exec(db, mmap.c_str(), nullptr, nullptr, nullptr);
+    return true;
+}
+
+void Database::prepareReader(sqlite3* db) const {
+    sqlite3_busy_timeout(db, BUSY_TIMEOUT_MS);
+
+    if (m_queryAuditor) {
+        m_queryAuditor->watch(db);
+    }
+
+    // The dataset only changes while no reads are running, see detachDataset.
+    if (m_datasetAttached) {
+        attachDatasetTo(db);
+    }
+}
+
+void Database::detachDataset() {
+    if (!m_datasetAttached) {
+        return;
+    }
+
+    m_connections->closeReaders();
+    m_statementCache->clear();
+
+    const std::string query = "DETACH DATABASE " + std::string(DATASET_SCHEMA) + ";";
+    char* errMsg = nullptr;
+
+    if (sqlite3_exec(m_db, query.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "Failed to detach dataset: " << errMsg << std::endl;
+        sqlite3_free(errMsg);
+        return;
+    }
+
+    m_datasetAttached = false;
+}
+
+bool Database::swapDataset(DatasetBuild& build) {
+    detachDataset();
+    const bool swapped = !m_datasetAttached && build.commit();
+    attachDataset();
+    return swapped;
+}
+
+void Database::migrateLegacyDataset() {
+    if (!fileExists(datasetPath().string())) {
+        DatasetBuild build(datasetPath(), readSQLFile(DATASET_SCHEMA_PATH), false);
+
+        if (!build.isOpen() ||
+            !copyTables(build.connection(), m_dbPath, TableRegistry::datasetTables(), tableExists("dataset_row_hashes")) ||
+            !buildCompactSchema(build.connection()) || !build.commit()) {
+            std::cerr << "Failed to move dataset tables out of " << m_dbPath << ". Keeping them in place." << std::endl;
+            return;
+        }
+    }
+
+    std::string dropStatements;
+    for (const auto& table : TableRegistry::datasetTables()) {
+        dropStatements += "DROP TABLE IF EXISTS main." + table + ";";
+    }
+    dropStatements += "DROP TABLE IF EXISTS main.dataset_row_hashes;";
+
+    char* errMsg = nullptr;
+    if (sqlite3_exec(m_db, dropStatements.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "Failed to drop legacy dataset tables: " << errMsg << std::endl;
+        sqlite3_free(errMsg);
+        return;
+    }
+
+    sqlite3_exec(m_db, "VACUUM;", nullptr, nullptr, nullptr);
+    std::cout << "Moved dataset tables from " << m_dbPath << " to " << datasetPath() << std::endl;
+}
+
+bool Database::copyTables(sqlite3* datasetDb,
+                          const std::string& sourcePath,
+                          std::span<const std::string> tables,
+                          bool withRowHashes) {
+    sqlite3_stmt* stmt = nullptr;
+    bool attached = false;
+
+    if (sqlite3_prepare_v2(datasetDb, "ATTACH DATABASE ? AS source;", -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, sourcePath.c_str(), -1, SQLITE_TRANSIENT);
+        attached = sqlite3_step(stmt) == SQLITE_DONE;
+    }
+    sqlite3_finalize(stmt);
+
+    if (!attached) {
+        return false;
+    }
+
+    std::string copyStatements = "BEGIN TRANSACTION;";
+    for (const auto& table : tables) {
+        copyStatements += "INSERT INTO main." + table + " SELECT * FROM source." + table + ";";
+    }
+    if (withRowHashes) {
+        copyStatements += "INSERT INTO main.dataset_row_hashes SELECT * FROM source.dataset_row_hashes;";
+    }
+    copyStatements += "COMMIT;";
+
+    char* errMsg = nullptr;
+    const bool copied = sqlite3_exec(datasetDb, copyStatements.c_str(), nullptr, nullptr, &errMsg) == SQLITE_OK;
+
+    if (!copied) {
+        std::cerr << "Failed to copy dataset tables from " << sourcePath << ": " << errMsg << std::endl;
+        sqlite3_free(errMsg);
+        sqlite3_exec(datasetDb, "ROLLBACK;", nullptr, nullptr, nullptr);
+    }
+
+    sqlite3_exec(datasetDb, "DETACH DATABASE source;", nullptr, nullptr, nullptr);
+    return copied;
+}
+
+bool Database::buildCompactSchema(sqlite3* datasetDb) {
+    const std::string sql = readSQLFile(COMPACT_SCHEMA_PATH);
+    if (sql.empty()) {
+        return false;
+    }
+
+    const std::string statements = "BEGIN TRANSACTION;" + sql + "COMMIT;";
+    char* errMsg = nullptr;
+
+    if (sqlite3_exec(datasetDb, statements.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "Failed to build compact dataset tables: " << errMsg << std::endl;
+        sqlite3_free(errMsg);
+        sqlite3_exec(datasetDb, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return false;
+    }
+
+    const std::string version = "PRAGMA user_version=" + std::to_string(COMPACT_SCHEMA_VERSION) + ";";
+    sqlite3_exec(datasetDb, version.c_str(), nullptr, nullptr, nullptr);
+    return true;
+}
+
+int Database::compactSchemaVersion() const {
+    const std::string query = "PRAGMA " + std::string(DATASET_SCHEMA) + ".user_version;";
+    sqlite3_stmt* stmt = nullptr;
+    int version = 0;
+
+    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK && sqlite3_step(stmt) == SQLITE_ROW) {
+        version = sqlite3_column_int(stmt, 0);
+    }
+
+    sqlite3_finalize(stmt);
+    return version;
+}
+
+void Database::ensureCompactSchema() {
+    if (!m_datasetAttached || compactSchemaVersion() >= COMPACT_SCHEMA_VERSION) {
+        return;
+    }
+
+    DatasetBuild build(datasetPath(), readSQLFile(DATASET_SCHEMA_PATH), true);
+    if (!build.isOpen() || !buildCompactSchema(build.connection()) || !swapDataset(build)) {
+        std::cerr << "Failed to add compact tables to dataset " << datasetPath() << std::endl;
+    }
+}
+
+std::string Database::readSQLFile(std::string_view filePath) {
     std::ifstream file(filePath.data());
 
     if (!file.is_open()) {
         std::cerr << "Failed to open SQL file: " << filePath << std::endl;
-        return;
+        return "";
     }
 
     std::stringstream ss;
-    std::string line;
+    ss << file.rdbuf();
+    return ss.str();
+}
+
+void Database::executeSQLFile(std::string_view filePath) {
+    const std::string sql = readSQLFile(filePath);
 
-    while (std::getline(file, line)) {
-        ss << line << "\n";
+    if (sql.empty()) {
+        return;
     }
 
     char* errMsg = nullptr;
-    if (sqlite3_exec(m_db, ss.str().c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+    if (sqlite3_exec(m_db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
         std::cerr << "SQL schema execution error: " << errMsg << std::endl;
         sqlite3_free(errMsg);
     }
 }
 
-std::string Database::sanitizeCSVValue(std::string_view value) const {
-    if (value.empty()) {
-        return "NULL";
+bool Database::streamDatasetIntoDatabase(sqlite3* db,
+                                         std::span<const std::string> tableNames,
+                                         bool applyDelta,
+                                         ProgressCallback progressCallback) {
+    if (progressCallback) {
+        progressCallback("Downloading dataset from Kaggle", 20);
     }
 
-    auto startPos = value.find_first_not_of(" \t\n\r");
-    if (startPos == std::string_view::npos) {
-        return "NULL";
-    }
-    auto endPos = value.find_last_not_of(" \t\n\r");
-    value = value.substr(startPos, endPos - startPos + 1);
+    KaggleAPIClient client;
+    ByteStream archiveStream(ARCHIVE_STREAM_CHUNKS);
+    bool downloaded = false;
 
-    if (value.size() > 1 && value.front() == '"' && value.back() == '"') {
-        value = value.substr(1, value.size() - 2);
+    {
+        std::lock_guard lock(m_archiveStreamMutex);
+        m_archiveStream = &archiveStream;
     }
 
-    std::string result;
-    result.reserve(value.size() + 10);
-    result += '\'';
-    
-    for (char c : value) {
-        if (c == '\'') {
-            result += "''";
-        } else if (c == '\n') {
-            result += ' ';
+    std::thread download([&]() {
+        downloaded = client.downloadDataset(DATASET_NAME, DATASET_ARCHIVE_PATH, &archiveStream, m_importProgress);
+    });
+
+    {
+        ZipStreamReader entries(archiveStream, [tableNames](std::string_view fileName) {
+            return fileName.ends_with(".csv") && 
+                   std::ranges::find(tableNames, fileName.substr(0, fileName.size() - 4)) != tableNames.end();
+        });
+
+        if (applyDelta) {
+            DeltaImporter importer(db);
+            importer.setProgress(m_importProgress);
+            m_lastChangeSet = importer.applyStreamChanges(entries, tableNames, progressCallback, 35, 35);
         } else {
-            result += c;
+            runFullImport(db, tableNames, progressCallback, [&](ParallelImporter& importer) {
+                return importer.importStream(entries, tableNames, progressCallback, 30, 35);
+            });
         }
     }
-    
-    result += '\'';
-    return result;
-}
-
-std::vector<std::string> Database::getSanitizedValues(std::ifstream& file, std::string& line) const {
-    std::vector<std::string> values;
-    std::string tempValue;
-    bool inQuotes = false;
-
-    while (true) {
-        for (char c : line) {
-            if (c == '"') {
-                inQuotes = !inQuotes; 
-            } else if (c == ',' && !inQuotes) {
-                values.push_back(sanitizeCSVValue(tempValue));
-                tempValue.clear();
-            } else {
-                tempValue += c;
-            }
-        }
 
-        if (inQuotes) { 
-            std::string nextLine;
-            if (!std::getline(file, nextLine)) {
-                break;
-            }
-            tempValue += "\n" + nextLine;
-            line = nextLine;
-        } else {
-            break; 
-        }
+    download.join();
+
+    {
+        std::lock_guard lock(m_archiveStreamMutex);
+        m_archiveStream = nullptr;
+    }
+
+    if (!downloaded) {
+        std::cerr << "Failed to download dataset." << std::endl;
     }
 
-    values.push_back(sanitizeCSVValue(tempValue));
-    return values;
+    return downloaded;
 }
 
-bool Database::downloadAndExtractDataset(bool updateDataset, ProgressCallback progressCallback) {
-    const std::string datasetPath = "player-scores.zip";
+void Database::loadDataIntoDatabase(ProgressCallback progressCallback) {
+    if (buildDataset(progressCallback)) {
+        finishDatasetLoad(progressCallback);
+    }
+}
 
-    if (updateDataset || !fileExists(datasetPath)) {
-        if (progressCallback) {
-            progressCallback("Downloading dataset from Kaggle", 20);
-        }
-        
-        KaggleAPIClient client;
-        
-        if (!client.downloadDataset("davidcariboo/player-scores", datasetPath)) {
-            std::cerr << "Failed to download dataset." << std::endl;
-            return false;
-        }
+void Database::finishDatasetLoad(ProgressCallback progressCallback) {
+    setLastUpdateTimestamp();
+
+    std::string deferredTables;
+    for (const auto& table : TableRegistry::deferredTables()) {
+        deferredTables += (deferredTables.empty() ? "" : ",") + table;
     }
+    setMetadataValue(DEFERRED_TABLES_KEY, deferredTables);
 
-    if (updateDataset || !fs::exists("data")) {
-        if (progressCallback) {
-            progressCallback("Extracting dataset files", 25);
-        }
-        
-        if (!fs::exists("data")) {
-            fs::create_directory("data");
-        }
-        
-        try {
-            #ifdef _WIN32
-                std::string cmd = "powershell -Command \"Expand-Archive -Path player-scores.zip -DestinationPath data -Force\"";
-                int result = std::system(cmd.c_str());
-                if (result != 0) {
-                    std::cerr << "Error extracting zip file with PowerShell. Return code: " << result << std::endl;
-                    return false;
-                }
-            #else
-                int result = std::system("unzip -o player-scores.zip -d data");
-                if (result != 0) {
-                    std::cerr << "Error extracting zip file with unzip. Return code: " << result << std::endl;
-                    return false;
-                }
-            #endif
-        } catch (const std::exception& e) {
-            std::cerr << "Exception while extracting dataset: " << e.what() << std::endl;
-            return false;
-        }
+    if (progressCallback) {
+        progressCallback("Writing rating replay cache", 72);
     }
-    
-    if (!fs::exists("data/players.csv")) {
-        std::cerr << "Dataset extraction failed. Could not find CSV files in data directory." << std::endl;
+    ReplayCache::write(m_db, replayCachePath(), datasetVersion());
+}
+
+bool Database::buildDataset(ProgressCallback progressCallback) {
+    DatasetBuild build(datasetPath(), readSQLFile(DATASET_SCHEMA_PATH), false);
+    if (!build.isOpen()) {
+        std::cerr << "Failed to prepare dataset build. Database initialization aborted." << std::endl;
+        return false;
+    }
+
+    sqlite3* db = build.connection();
+    const bool imported = importDataset(db, false, progressCallback);
+    recordImportTelemetry();
+
+    if (!imported) {
+        std::cerr << "Failed to download or import dataset. Database initialization aborted." << std::endl;
+        return false;
+    }
+
+    if (!hasRows(db, "players")) {
+        std::cerr << "Essential dataset tables are empty. Database initialization aborted." << std::endl;
+        return false;
+    }
+
+    if (progressCallback) {
+        progressCallback("Finalizing database setup", 70);
+    }
+
+    if (!buildCompactSchema(db)) {
+        std::cerr << "Failed to derive compact dataset tables. Keeping the previous dataset." << std::endl;
+        return false;
+    }
+
+    // Imports skip the deferred tables, so a fresh build takes over whatever the
+    // previous dataset held in them instead of dropping it.
+    if (fileExists(datasetPath().string()) &&
+        !copyTables(db, datasetPath().string(), TableRegistry::deferredTables(), false)) {
+        std::cerr << "Failed to keep the deferred tables of the previous dataset." << std::endl;
+    }
+
+    if (!swapDataset(build)) {
+        std::cerr << "Failed to activate the new dataset. Keeping the previous one." << std::endl;
         return false;
     }
-    
     return true;
 }
 
-std::string Database::joinStrings(std::span<const std::string> values, std::string_view delimiter) const {
-    std::ostringstream result;
-    for (size_t i = 0; i < values.size(); ++i) {
-        result << values[i];
-        if (i < values.size() - 1) {
-            result << delimiter;
+std::unique_ptr<DatasetPatch> Database::prepareDatasetUpdate(ProgressCallback progressCallback) {
+    if (getKaggleUsername().empty() || getKaggleKey().empty()) {
+        if (progressCallback) {
+            progressCallback("Kaggle credentials not set. Skipping update check.", 100);
         }
+        return nullptr;
+    }
+
+    if (progressCallback) {
+        progressCallback("Checking for dataset updates", 5);
     }
-    return result.str();
-}
 
-void Database::loadDataIntoDatabase(bool updateDataset, ProgressCallback progressCallback) {
-    std::vector<std::string> tableNames {
-        "appearances", "club_games", "clubs", "competitions",
-        "game_events", "game_lineups", "games", "player_valuations",
-        "players", "transfers"
-    };
+    const time_t kaggleUpdatedTime = getKaggleDatasetLastUpdated();
+    if (kaggleUpdatedTime == 0) {
+        std::cerr << "Failed to get dataset last updated timestamp." << std::endl;
+        return nullptr;
+    }
+
+    if (kaggleUpdatedTime <= getLastUpdateTimestamp()) {
+        if (progressCallback) {
+            progressCallback("Dataset is already up-to-date", 100);
+        }
+        return nullptr;
+    }
+
+    if (!m_datasetAttached) {
+        std::cerr << "No dataset is attached to update." << std::endl;
+        return nullptr;
+    }
 
     if (progressCallback) {
-        progressCallback("Downloading dataset", 20);
+        progressCallback("New dataset available, updating", 10);
     }
-    
-    bool downloadSuccess = downloadAndExtractDataset(updateDataset, progressCallback);
-    
-    if (!downloadSuccess) {
-        std::cerr << "Failed to download or extract dataset. Database initialization aborted." << std::endl;
-        return;
+
+    auto patch = std::make_unique<DatasetPatch>(datasetPath(), TableRegistry::requiredTables());
+    if (!patch->isOpen()) {
+        std::cerr << "Failed to prepare dataset update. Keeping the previous dataset." << std::endl;
+        return nullptr;
     }
-    
-    if (!fs::exists("data") || !fs::exists("data/players.csv")) {
-        std::cerr << "Data directory or essential CSV files missing. Database initialization aborted." << std::endl;
-        return;
+
+    if (!importDataset(patch->connection(), true, progressCallback)) {
+        std::cerr << "Failed to download dataset update. Keeping the previous dataset." << std::endl;
+        return nullptr;
     }
 
-    int baseProgress = 30;
-    int progressPerTable = 40 / static_cast<int>(tableNames.size());
-    
-    for (size_t i = 0; i < tableNames.size(); i++) {
-        std::string tableName = tableNames[i];
-        std::string csvPath = "data/" + tableName + ".csv";
-        
-        if (!fileExists(csvPath)) {
-            std::cerr << "Warning: CSV file not found: " << csvPath << ". Skipping this table." << std::endl;
-            continue;
-        }
-        
+    return patch;
+}
+
+bool Database::applyDatasetUpdate(std::unique_ptr<DatasetPatch> patch, ProgressCallback progressCallback) {
+    recordImportTelemetry();
+
+    if (!patch) {
+        return false;
+    }
+
+    if (!m_lastChangeSet.empty()) {
         if (progressCallback) {
-            progressCallback("Loading " + tableName + " data", baseProgress + static_cast<int>(i) * progressPerTable);
+            progressCallback("Applying dataset changes", 70);
+        }
+
+        const std::string maintenanceSql = readSQLFile(COMPACT_DELTA_SCHEMA_PATH);
+
+        detachDataset();
+        const bool applied = !m_datasetAttached && !maintenanceSql.empty() && patch->apply(maintenanceSql);
+        attachDataset();
+
+        if (!applied) {
+            std::cerr << "Failed to apply dataset update. Keeping the previous dataset." << std::endl;
+            m_lastChangeSet = DatasetChangeSet{};
+            return false;
         }
-        loadCSVIntoTable(tableName, csvPath);
     }
 
-    if (progressCallback) {
-        progressCallback("Finalizing database setup", 70);
+    finishDatasetLoad(progressCallback);
+    return !m_lastChangeSet.empty();
+}
+
+void Database::cancelDatasetUpdate() {
+    std::lock_guard lock(m_archiveStreamMutex);
+    if (m_archiveStream) {
+        m_archiveStream->cancel();
     }
-    setLastUpdateTimestamp();
 }
 
-std::string Database::buildInsertQuery(std::string_view tableName, 
-                                     std::span<const std::string> columns, 
-                                     std::ifstream& file) const {
-    std::stringstream sqlBatch;
-    sqlBatch << "BEGIN TRANSACTION;\n";
+bool Database::importDataset(sqlite3* db, bool applyDelta, ProgressCallback progressCallback) {
+    const auto& tableNames = TableRegistry::requiredTables();
+    bool imported = true;
 
-    std::string columnList = "(" + joinStrings(columns, ", ") + ")";
-    sqlBatch << "INSERT OR REPLACE INTO " << tableName << " " << columnList << " VALUES ";
+    ImportProgress progress(progressCallback, 20, 45);
+    const ProgressCallback importCallback = progress.statusCallback();
+    m_importProgress = &progress;
 
-    bool firstRow = true;
-    appendCSVRowsToQuery(file, sqlBatch, firstRow);
-    
-    sqlBatch << ";\nCOMMIT;\n";
-    return sqlBatch.str();
+    if (applyDelta || !fileExists(DATASET_ARCHIVE_PATH)) {
+        imported = streamDatasetIntoDatabase(db, tableNames, applyDelta, importCallback);
+    } else {
+        importTables(db, collectImportSources(tableNames), importCallback);
+    }
+
+    m_importProgress = nullptr;
+    m_importTelemetry = ImportProgress::formatSummary(progress.stop());
+    return imported;
 }
 
-void Database::appendCSVRowsToQuery(std::ifstream& file, std::stringstream& sqlBatch, bool& firstRow) const {
-    std::string line;
-    while (std::getline(file, line)) {
-        std::vector<std::string> values = getSanitizedValues(file, line);
-        if (values.empty()) {
+void Database::recordImportTelemetry() {
+    if (!m_importTelemetry.empty()) {
+        setMetadataValue(IMPORT_TELEMETRY_KEY, m_importTelemetry);
+        m_importTelemetry.clear();
+    }
+}
+
+std::vector<ImportSource> Database::collectImportSources(std::span<const std::string> tableNames) const {
+    const ZipArchive archive(DATASET_ARCHIVE_PATH);
+    std::vector<ImportSource> sources;
+    sources.reserve(tableNames.size());
+    
+    for (const auto& tableName : tableNames) {
+        std::string csvName = tableName + ".csv";
+        
+        if (archive.isOpen() && archive.findEntry(csvName)) {
+            sources.push_back({tableName, std::move(csvName), DATASET_ARCHIVE_PATH});
             continue;
         }
 
-        if (!firstRow) {
-            sqlBatch << ",";
+        std::string csvPath = "data/" + csvName;
+        
+        if (!fileExists(csvPath)) {
+            std::cerr << "Warning: CSV file not found: " << csvName << ". Skipping this table." << std::endl;
+            continue;
         }
         
-        appendRowValuesToQuery(values, sqlBatch);
-        firstRow = false;
+        sources.push_back({tableName, std::move(csvPath), {}});
     }
+
+    return sources;
 }
 
-void Database::appendRowValuesToQuery(std::span<const std::string> values, std::stringstream& sqlBatch) const {
-    sqlBatch << "(";
-    for (size_t i = 0; i < values.size(); i++) {
-        sqlBatch << values[i];
-        if (i < values.size() - 1) {
-            sqlBatch << ",";
+bool Database::isTableLoaded(std::string_view tableName) const {
+    const std::string deferred = getMetadataValue(DEFERRED_TABLES_KEY);
+
+    for (const auto table : std::views::split(std::string_view(deferred), ',')) {
+        if (std::string_view(table.begin(), table.end()) == tableName) {
+            return false;
         }
     }
-    sqlBatch << ")";
+
+    return true;
 }
 
-void Database::executeCSVImportQuery(std::string_view query, std::string_view csvPath, std::string_view tableName) {
-    char* errMsg = nullptr;
-    if (sqlite3_exec(m_db, query.data(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
-        std::cerr << "SQL error: " << errMsg << std::endl;
-        sqlite3_free(errMsg);
-    } else {
-        std::cout << "Data from " << csvPath << " imported into " << tableName << std::endl;
+void Database::importTables(sqlite3* db, std::span<const ImportSource> sources, ProgressCallback progressCallback) {
+    std::vector<std::string> tableNames;
+    for (const auto& source : sources) {
+        tableNames.push_back(source.tableName);
     }
+
+    runFullImport(db, tableNames, progressCallback, [&](ParallelImporter& importer) {
+        return importer.importTables(sources, progressCallback, 30, 35);
+    });
 }
 
-time_t Database::getLastUpdateTimestamp() const {
-    const char* query = "SELECT value FROM metadata WHERE key = 'last_updated';";
-    sqlite3_stmt* stmt = nullptr;
-    time_t lastUpdated = 0;
+void Database::runFullImport(sqlite3* db,
+                             std::span<const std::string> tableNames,
+                             ProgressCallback progressCallback,
+                             const std::function<std::vector<ImportStats>(ParallelImporter&)>& runImport) {
+    if (progressCallback) {
+        progressCallback("Loading dataset tables", 30);
+    }
 
-    if (sqlite3_prepare_v2(m_db, query, -1, &stmt, nullptr) == SQLITE_OK) {
-        if (sqlite3_step(stmt) == SQLITE_ROW) {
-            lastUpdated = std::stol(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+    std::optional<BulkLoadSession> bulkLoad;
+    if (m_bulkLoadEnabled) {
+        bulkLoad.emplace(db, tableNames);
+    }
+
+    ParallelImporter importer(db, "import-staging");
+    importer.setProgress(m_importProgress);
+    const auto results = runImport(importer);
+
+    if (bulkLoad) {
+        if (progressCallback) {
+            progressCallback("Building indexes", 65);
         }
+        bulkLoad->markLoaded();
+        bulkLoad->finish();
     }
-    sqlite3_finalize(stmt);
-    return lastUpdated;
+
+    size_t totalRows = 0;
+    for (const auto& stats : results) {
+        totalRows += stats.rowsImported;
+    }
+    std::cout << "Imported " << totalRows << " rows in total" << std::endl;
+
+    m_lastChangeSet = DatasetChangeSet{};
+    m_lastChangeSet.fullReload = true;
+}
+
+time_t Database::getLastUpdateTimestamp() const {
+    const std::string value = getMetadataValue("last_updated");
+    return value.empty() ? 0 : std::stol(value);
 }
 
 void Database::setLastUpdateTimestamp() {
@@ -425,45 +758,11 @@ std::string Database::formatTimestamp(time_t timestamp) const {
     return std::string(buffer);
 }
 
-void Database::updateDatasetIfNeeded(ProgressCallback progressCallback) {
-    std::string kaggleUsername = getMetadataValue("KAGGLE_USERNAME");
-    std::string kaggleKey = getMetadataValue("KAGGLE_KEY");
-
-    if (kaggleUsername.empty() || kaggleKey.empty()) {
-        if (progressCallback) {
-            progressCallback("Kaggle credentials not set. Skipping update check.", 70);
-        }
-        return;
-    }
-
-    if (progressCallback) {
-        progressCallback("Checking for dataset updates", 25);
-    }
-    
-    time_t kaggleUpdatedTime = getKaggleDatasetLastUpdated();
-
-    if (kaggleUpdatedTime == 0) {
-        std::cerr << "Failed to get dataset last updated timestamp." << std::endl;
-        return;
-    }
-
-    if (progressCallback) {
-        progressCallback("Comparing dataset versions", 30);
-    }
-    
-    compareAndUpdateDataset(kaggleUpdatedTime, progressCallback);
-}
-
 std::string Database::getMetadataValue(std::string_view key) const {
-    if (!tableExists("metadata")) {
-        return "";
-    }
-    
-    sqlite3_stmt* stmt = nullptr;
     std::string value;
-    std::string query = "SELECT value FROM metadata WHERE key = ?;";
 
-    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+    // Fails to compile while the metadata table does not exist yet, which reads as an empty value.
+    if (auto stmt = m_statementCache->acquire("SELECT value FROM metadata WHERE key = ?;")) {
         sqlite3_bind_text(stmt, 1, key.data(), static_cast<int>(key.size()), SQLITE_TRANSIENT);
 
         if (sqlite3_step(stmt) == SQLITE_ROW) {
@@ -472,12 +771,15 @@ std::string Database::getMetadataValue(std::string_view key) const {
         }
     }
 
-    sqlite3_finalize(stmt);
     return value;
 }
 
 void Database::setMetadataValue(std::string_view key, std::string_view value) {
-    if (!tableExists("metadata")) {
+    constexpr std::string_view query = "INSERT INTO metadata (key, value) VALUES (?, ?) "
+                                       "ON CONFLICT(key) DO UPDATE SET value = excluded.value;";
+    
+    auto stmt = m_statementCache->acquire(query);
+    if (!stmt) {
         char* errMsg = nullptr;
         if (sqlite3_exec(m_db, "CREATE TABLE IF NOT EXISTS metadata (key TEXT PRIMARY KEY, value TEXT);", 
                         nullptr, nullptr, &errMsg) != SQLITE_OK) {
@@ -485,13 +787,10 @@ void Database::setMetadataValue(std::string_view key, std::string_view value) {
             sqlite3_free(errMsg);
             return;
         }
+        stmt = m_statementCache->acquire(query);
     }
     
-    sqlite3_stmt* stmt = nullptr;
-    std::string query = "INSERT INTO metadata (key, value) VALUES (?, ?) "
-                        "ON CONFLICT(key) DO UPDATE SET value = excluded.value;";
-    
-    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+    if (stmt) {
         sqlite3_bind_text(stmt, 1, key.data(), static_cast<int>(key.size()), SQLITE_TRANSIENT);
         sqlite3_bind_text(stmt, 2, value.data(), static_cast<int>(value.size()), SQLITE_TRANSIENT);
 
@@ -499,8 +798,6 @@ void Database::setMetadataValue(std::string_view key, std::string_view value) {
             std::cerr << "Failed to set metadata value for key: " << key << std::endl;
         }
     }
-
-    sqlite3_finalize(stmt);
 }
 
 time_t Database::getKaggleDatasetLastUpdated() const {
@@ -516,22 +813,7 @@ time_t Database::getKaggleDatasetLastUpdated() const {
         m_kaggleClient = std::make_unique<KaggleAPIClient>(kaggleUsername, kaggleKey);
     }
     
-    return m_kaggleClient->getDatasetLastUpdated("davidcariboo/player-scores");
-}
-
-void Database::compareAndUpdateDataset(time_t kaggleUpdatedTime, ProgressCallback progressCallback) {
-    time_t lastUpdated = getLastUpdateTimestamp();
-
-    if (kaggleUpdatedTime > lastUpdated) {
-        if (progressCallback) {
-            progressCallback("New dataset available, updating", 35);
-        }
-        loadDataIntoDatabase(true, progressCallback);
-    } else {
-        if (progressCallback) {
-            progressCallback("Dataset is already up-to-date", 70);
-        }
-    }
+    return m_kaggleClient->getDatasetLastUpdated(DATASET_NAME);
 }
 
 std::string Database::getKaggleUsername() const {
@@ -547,22 +829,7 @@ void Database::setKaggleCredentials(std::string_view username, std::string_view
     setMetadataValue("KAGGLE_KEY", key);
 }
 
-void Database::loadCSVIntoTable(std::string_view tableName, std::string_view csvPath) {
-    std::ifstream file(csvPath.data());
-    if (!file.is_open()) {
-        std::cerr << "Failed to open CSV file: " << csvPath << std::endl;
-        return;
-    }
-
-    std::string headerLine;
-    std::getline(file, headerLine);
-    std::vector<std::string> columns = getSanitizedValues(file, headerLine);
-    
-    if (columns.empty()) {
-        std::cerr << "Error: Could not extract columns from CSV file: " << csvPath << std::endl;
-        return;
-    }
-
-    std::string query = buildInsertQuery(tableName, columns, file);
-    executeCSVImportQuery(query, csvPath, tableName);
+ImportStats Database::loadCSVIntoTable(std::string_view tableName, std::string_view csvPath) {
+    CSVImporter importer(m_db);
+    return importer.importFile(tableName, csvPath);
 }
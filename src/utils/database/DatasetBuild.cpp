@@ -0,0 +1,84 @@
+#include "utils/database/DatasetBuild.h"
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+DatasetBuild::DatasetBuild(fs::path targetPath, std::string_view schemaSql, bool fromExisting)
+    : m_targetPath(std::move(targetPath))
+    , m_buildPath(m_targetPath.string() + ".building") {
+    removeFiles(m_buildPath);
+
+    if (fromExisting) {
+        std::error_code ec;
+        fs::copy_file(m_targetPath, m_buildPath, fs::copy_options::overwrite_existing, ec);
+
+        if (ec) {
+            std::cerr << "Failed to copy dataset " << m_targetPath << " for update: " << ec.message() << std::endl;
+            return;
+        }
+    }
+
+    const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+    if (sqlite3_open_v2(m_buildPath.string().c_str(), &m_db, flags, nullptr) != SQLITE_OK) {
+        std::cerr << "Can't open dataset build " << m_buildPath << ": " << sqlite3_errmsg(m_db) << std::endl;
+        close();
+        return;
+    }
+
+    if (!execute("PRAGMA journal_mode=DELETE;") || !execute(std::string(schemaSql))) {
+        close();
+        removeFiles(m_buildPath);
+    }
+}
+
+DatasetBuild::~DatasetBuild() {
+    if (!m_committed) {
+        close();
+        removeFiles(m_buildPath);
+    }
+}
+
+bool DatasetBuild::commit() {
+    if (!isOpen() || m_committed) {
+        return false;
+    }
+
+    execute("PRAGMA optimize;");
+    close();
+
+    std::error_code ec;
+    fs::rename(m_buildPath, m_targetPath, ec);
+
+    if (ec) {
+        std::cerr << "Failed to swap in new dataset " << m_targetPath << ": " << ec.message() << std::endl;
+        removeFiles(m_buildPath);
+        return false;
+    }
+
+    m_committed = true;
+    return true;
+}
+
+bool DatasetBuild::execute(const std::string& sql) const {
+    char* errMsg = nullptr;
+    if (sqlite3_exec(m_db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "Dataset build error: " << errMsg << std::endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
+    return true;
+}
+
+void DatasetBuild::close() {
+    if (m_db) {
+        sqlite3_close(m_db);
+        m_db = nullptr;
+    }
+}
+
+void DatasetBuild::removeFiles(const fs::path& path) {
+    std::error_code ec;
+    for (const char* suffix : {"", "-journal", "-wal", "-shm"}) {
+        fs::remove(path.string() + suffix, ec);
+    }
+}
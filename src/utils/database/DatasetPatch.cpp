@@ -0,0 +1,159 @@
+#include "utils/database/DatasetPatch.h"
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    constexpr const char* ROW_HASHES_TABLE = "dataset_row_hashes";
+    constexpr const char* PATCH_SCHEMA = "patch";
+
+}
+
+DatasetPatch::DatasetPatch(fs::path datasetPath, std::span<const std::string> tableNames)
+    : m_datasetPath(std::move(datasetPath))
+    , m_patchPath(m_datasetPath.string() + ".patch")
+    , m_tableNames(tableNames.begin(), tableNames.end()) {
+    removeFiles(m_patchPath);
+
+    const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+    if (sqlite3_open_v2(m_patchPath.string().c_str(), &m_db, flags, nullptr) != SQLITE_OK) {
+        std::cerr << "Can't open dataset patch " << m_patchPath << ": " << sqlite3_errmsg(m_db) << std::endl;
+        close();
+        return;
+    }
+
+    // The patch is thrown away if anything fails before it is applied.
+    if (!execute(m_db, "PRAGMA synchronous=OFF;") || !attach(m_db, m_datasetPath, LIVE_SCHEMA) || !createTables()) {
+        close();
+        removeFiles(m_patchPath);
+    }
+}
+
+DatasetPatch::~DatasetPatch() {
+    close();
+    removeFiles(m_patchPath);
+}
+
+bool DatasetPatch::createTables() {
+    const std::string query = "SELECT sql FROM " + std::string(LIVE_SCHEMA) + ".sqlite_master WHERE type = 'table' AND name = ?;";
+    sqlite3_stmt* stmt = nullptr;
+
+    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Failed to read dataset schema: " << sqlite3_errmsg(m_db) << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> tables = m_tableNames;
+    tables.emplace_back(ROW_HASHES_TABLE);
+
+    std::string statements;
+    for (const auto& table : tables) {
+        sqlite3_bind_text(stmt, 1, table.c_str(), -1, SQLITE_STATIC);
+
+        const auto* sql = sqlite3_step(stmt) == SQLITE_ROW ? reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)) : nullptr;
+        if (!sql) {
+            std::cerr << "Dataset table " << table << " is missing, can't patch it." << std::endl;
+            sqlite3_finalize(stmt);
+            return false;
+        }
+
+        statements += std::string(sql) + ";";
+        sqlite3_reset(stmt);
+    }
+    sqlite3_finalize(stmt);
+
+    statements += "CREATE TABLE " + std::string(REPLACED_ROWS_TABLE) + " ("
+                  "table_name TEXT NOT NULL, row_id INTEGER NOT NULL, key_hash INTEGER NOT NULL, "
+                  "deleted INTEGER NOT NULL, PRIMARY KEY (table_name, row_id)) WITHOUT ROWID;";
+
+    return execute(m_db, statements);
+}
+
+bool DatasetPatch::apply(std::string_view maintenanceSql) {
+    if (!isOpen()) {
+        return false;
+    }
+    close();
+
+    sqlite3* db = nullptr;
+    if (sqlite3_open_v2(m_datasetPath.string().c_str(), &db, SQLITE_OPEN_READWRITE, nullptr) != SQLITE_OK) {
+        std::cerr << "Can't open dataset " << m_datasetPath << " for update: " << sqlite3_errmsg(db) << std::endl;
+        sqlite3_close(db);
+        return false;
+    }
+
+    if (!attach(db, m_patchPath, PATCH_SCHEMA)) {
+        sqlite3_close(db);
+        return false;
+    }
+
+    const std::string patch(PATCH_SCHEMA);
+    const std::string replaced = patch + "." + REPLACED_ROWS_TABLE;
+
+    std::string statements = "BEGIN IMMEDIATE;";
+    for (const auto& table : m_tableNames) {
+        const std::string replacedRowIds = "(SELECT row_id FROM " + replaced + " WHERE table_name = '" + table + "')";
+
+        statements += "CREATE TEMP TABLE previous_" + table + " AS SELECT * FROM main." + table +
+                      " WHERE rowid IN " + replacedRowIds + ";";
+        statements += "DELETE FROM main." + table + " WHERE rowid IN " + replacedRowIds + ";";
+        statements += "INSERT OR REPLACE INTO main." + table + " SELECT * FROM " + patch + "." + table + ";";
+    }
+
+    statements += "DELETE FROM main." + std::string(ROW_HASHES_TABLE) + " WHERE (table_name, key_hash) IN "
+                  "(SELECT table_name, key_hash FROM " + replaced + " WHERE deleted);";
+    statements += "INSERT OR REPLACE INTO main." + std::string(ROW_HASHES_TABLE) +
+                  " SELECT * FROM " + patch + "." + ROW_HASHES_TABLE + ";";
+    statements += std::string(maintenanceSql);
+    statements += "COMMIT;";
+
+    const bool applied = execute(db, statements);
+    if (!applied) {
+        sqlite3_exec(db, "ROLLBACK;", nullptr, nullptr, nullptr);
+    }
+
+    sqlite3_close(db);
+    return applied;
+}
+
+bool DatasetPatch::attach(sqlite3* db, const fs::path& path, std::string_view schema) {
+    sqlite3_stmt* stmt = nullptr;
+    bool attached = false;
+    const std::string query = "ATTACH DATABASE ? AS " + std::string(schema) + ";";
+
+    if (sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, path.string().c_str(), -1, SQLITE_TRANSIENT);
+        attached = sqlite3_step(stmt) == SQLITE_DONE;
+    }
+    sqlite3_finalize(stmt);
+
+    if (!attached) {
+        std::cerr << "Failed to attach " << path << ": " << sqlite3_errmsg(db) << std::endl;
+    }
+    return attached;
+}
+
+bool DatasetPatch::execute(sqlite3* db, const std::string& sql) {
+    char* errMsg = nullptr;
+    if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "Dataset patch error: " << errMsg << std::endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
+    return true;
+}
+
+void DatasetPatch::close() {
+    if (m_db) {
+        sqlite3_close(m_db);
+        m_db = nullptr;
+    }
+}
+
+void DatasetPatch::removeFiles(const fs::path& path) {
+    std::error_code ec;
+    for (const char* suffix : {"", "-journal", "-wal", "-shm"}) {
+        fs::remove(path.string() + suffix, ec);
+    }
+}
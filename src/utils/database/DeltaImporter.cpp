@@ -0,0 +1,494 @@
+#include "utils/database/DeltaImporter.h"
+#include "utils/database/CSVImporter.h"
+#include "utils/database/ImportProgress.h"
+#include "utils/database/DatasetPatch.h"
+#include <iostream>
+#include <algorithm>
+#include <ranges>
+#include <charconv>
+#include <thread>
+#include <bit>
+#include <filesystem>
+
+namespace {
+
+    constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+    constexpr char KEY_SEPARATOR = '\x1f';
+
+}
+
+bool DatasetChangeSet::empty() const noexcept {
+    return !fullReload && std::ranges::all_of(tables, [](const TableChanges& table) {
+        return table.inserted == 0 && table.updated == 0 && table.deleted == 0;
+    });
+}
+
+DeltaImporter::DeltaImporter(sqlite3* patchDb)
+    : m_db(patchDb) {
+}
+
+DatasetChangeSet DeltaImporter::applyChanges(std::span<const ImportSource> sources,
+                                             const ProgressCallback& progressCallback,
+                                             int baseProgress,
+                                             int progressRange) {
+    DatasetChangeSet changeSet;
+
+    if (m_progress) {
+        for (const auto& source : sources) {
+            m_progress->addExpectedBytes(ImportProgress::Stage::Parse, CSVSource::sourceSize(source));
+        }
+    }
+
+    for (size_t i = 0; i < sources.size(); i++) {
+        const auto& source = sources[i];
+
+        if (progressCallback) {
+            progressCallback("Comparing " + source.tableName + " data",
+                             baseProgress + static_cast<int>(i * progressRange / sources.size()));
+        }
+
+        CSVSource csv(source);
+        csv.setProgress(m_progress);
+        recordTableDelta(changeSet, applyTableChanges(source.tableName, csv));
+    }
+
+    finishChangeSet(changeSet);
+    return changeSet;
+}
+
+DatasetChangeSet DeltaImporter::applyStreamChanges(ZipStreamReader& entries,
+                                                   std::span<const std::string> tableNames,
+                                                   const ProgressCallback& progressCallback,
+                                                   int baseProgress,
+                                                   int progressRange) {
+    DatasetChangeSet changeSet;
+    size_t processed = 0;
+
+    while (auto entry = entries.nextEntry()) {
+        const std::string tableName = std::filesystem::path(entry->name).stem().string();
+        CSVSource csv(entry->name, entry->data);
+
+        if (std::ranges::find(tableNames, tableName) == tableNames.end()) {
+            continue;
+        }
+
+        if (m_progress) {
+            m_progress->addExpectedBytes(ImportProgress::Stage::Parse, entry->uncompressedSize);
+            csv.setProgress(m_progress);
+        }
+
+        if (progressCallback) {
+            const size_t expected = std::max(tableNames.size(), processed + 1);
+            progressCallback("Comparing " + tableName + " data",
+                             baseProgress + static_cast<int>(processed * progressRange / expected));
+        }
+
+        recordTableDelta(changeSet, applyTableChanges(tableName, csv));
+        processed++;
+    }
+
+    if (entries.failed()) {
+        std::cerr << "Dataset archive stream was incomplete. Only tables that arrived intact were updated." << std::endl;
+    }
+
+    finishChangeSet(changeSet);
+    return changeSet;
+}
+
+void DeltaImporter::recordTableDelta(DatasetChangeSet& changeSet, const TableDelta& delta) {
+    const auto& changes = delta.changes;
+
+    if (delta.failed) {
+        std::cerr << "Update of " << changes.tableName << " was incomplete. Row hashes were not recorded." << std::endl;
+    } else if (execute("BEGIN TRANSACTION;")) {
+        storeRowHashes(changes.tableName, delta.changedRows);
+        execute("COMMIT;");
+    }
+
+    std::cout << "Updated " << changes.tableName << ": " << changes.inserted << " inserted, " 
+              << changes.updated << " updated, " << changes.deleted << " deleted, " 
+              << changes.unchanged << " unchanged" << (changes.fullReload ? " (hash baseline recorded)" : "") 
+              << std::endl;
+
+    changeSet.fullReload = changeSet.fullReload || changes.fullReload;
+    changeSet.touchedGameIds.insert(changeSet.touchedGameIds.end(), 
+                                    delta.touchedGameIds.begin(), delta.touchedGameIds.end());
+    changeSet.tables.push_back(changes);
+}
+
+void DeltaImporter::finishChangeSet(DatasetChangeSet& changeSet) {
+    std::ranges::sort(changeSet.touchedGameIds);
+    const auto duplicates = std::ranges::unique(changeSet.touchedGameIds);
+    changeSet.touchedGameIds.erase(duplicates.begin(), duplicates.end());
+
+    std::cout << "Dataset update touched " << changeSet.touchedGameIds.size() << " games" << std::endl;
+}
+
+DeltaImporter::TableDelta DeltaImporter::applyTableChanges(const std::string& tableName, CSVSource& csv) {
+    TableDelta delta;
+    delta.changes.tableName = tableName;
+
+    if (!csv.isOpen()) {
+        std::cerr << "Failed to open CSV file: " << csv.label() << std::endl;
+        delta.failed = true;
+        return delta;
+    }
+
+    if (!csv.nextRecord()) {
+        std::cerr << "Error: Could not extract columns from CSV file: " << csv.label() << std::endl;
+        delta.failed = true;
+        return delta;
+    }
+
+    const std::vector<std::string> headers(csv.fields().begin(), csv.fields().end());
+    const auto keyColumns = fetchKeyColumns(tableName, headers);
+
+    std::vector<size_t> keyIndices;
+    for (const auto& column : keyColumns) {
+        keyIndices.push_back(static_cast<size_t>(std::ranges::find(headers, column) - headers.begin()));
+    }
+
+    const auto gameIdIt = std::ranges::find(headers, "game_id");
+    const bool hasGameId = gameIdIt != headers.end();
+    const size_t gameIdIndex = static_cast<size_t>(gameIdIt - headers.begin());
+
+    auto storedHashes = loadRowHashes(tableName);
+    const bool baseline = storedHashes.empty();
+    delta.changes.fullReload = baseline;
+
+    CSVRowQueue queue(CSVImporter::QUEUE_CAPACITY);
+
+    std::thread producer([&]() {
+        CSVRowBatch batch;
+        std::string rowKey;
+
+        while (csv.nextRecord()) {
+            const auto fields = csv.fields();
+
+            if (fields.size() != headers.size()) {
+                continue;
+            }
+
+            rowKey.clear();
+            for (size_t k = 0; k < keyIndices.size(); k++) {
+                if (k > 0) {
+                    rowKey += KEY_SEPARATOR;
+                }
+                rowKey += CSVImporter::trim(fields[keyIndices[k]]);
+            }
+
+            uint64_t rowHash = FNV_OFFSET_BASIS;
+            for (const auto field : fields) {
+                rowHash = hashBytes(field, rowHash);
+                rowHash = hashBytes({&KEY_SEPARATOR, 1}, rowHash);
+            }
+
+            const uint64_t keyHash = hashBytes(rowKey, FNV_OFFSET_BASIS);
+
+            const auto storedIt = storedHashes.find(keyHash);
+            const bool replacesRow = storedIt != storedHashes.end();
+
+            if (replacesRow) {
+                const bool unchanged = storedIt->second == rowHash;
+                storedHashes.erase(storedIt);
+
+                if (unchanged) {
+                    delta.changes.unchanged++;
+                    continue;
+                }
+                delta.changes.updated++;
+            } else {
+                delta.changes.inserted++;
+            }
+
+            delta.changedRows.push_back({keyHash, rowKey, rowHash, replacesRow});
+
+            if (hasGameId && !baseline) {
+                const auto gameIdField = CSVImporter::trim(fields[gameIdIndex]);
+                int gameId = 0;
+                if (std::from_chars(gameIdField.data(), gameIdField.data() + gameIdField.size(), gameId).ec == std::errc{}) {
+                    delta.touchedGameIds.push_back(gameId);
+                }
+            }
+
+            batch.appendRow(fields, csv);
+
+            if (batch.rowCount == CSVImporter::ROWS_PER_BATCH) {
+                if (!queue.push(std::move(batch))) {
+                    return;
+                }
+                batch = CSVRowBatch{};
+            }
+        }
+
+        if (batch.rowCount > 0) {
+            queue.push(std::move(batch));
+        }
+
+        queue.close();
+    });
+
+    CSVImporter importer(m_db);
+    const ImportStats stats = importer.importBatches(tableName, headers, queue);
+    queue.close();
+    producer.join();
+
+    // Rows that never reached the table keep their old hash, so the next update retries them.
+    const size_t rowsWritten = stats.rowsImported + stats.rejectedRows.size();
+    delta.failed = csv.failed() || rowsWritten < delta.changedRows.size();
+
+    if (!stats.rejectedRows.empty()) {
+        std::cerr << "Warning: " << stats.rejectedRows.size() << " changed rows of " << tableName 
+                  << " could not be written and will be retried on the next update" << std::endl;
+
+        for (const size_t row : stats.rejectedRows | std::views::reverse) {
+            delta.changedRows.erase(delta.changedRows.begin() + static_cast<std::ptrdiff_t>(row));
+        }
+    }
+
+    if (!baseline && !delta.failed) {
+        delta.deletedKeys.reserve(storedHashes.size());
+        for (const auto& [keyHash, _] : storedHashes) {
+            delta.deletedKeys.push_back(keyHash);
+        }
+    }
+
+    if (execute("BEGIN TRANSACTION;")) {
+        recordReplacedRows(tableName, keyColumns, hasGameId, delta);
+        execute("COMMIT;");
+    }
+
+    return delta;
+}
+
+std::unordered_map<uint64_t, uint64_t> DeltaImporter::loadRowHashes(std::string_view tableName) const {
+    std::unordered_map<uint64_t, uint64_t> hashes;
+    sqlite3_stmt* stmt = nullptr;
+    const std::string query = "SELECT key_hash, row_hash FROM " + std::string(DatasetPatch::LIVE_SCHEMA) +
+                              ".dataset_row_hashes WHERE table_name = ?;";
+
+    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, tableName.data(), static_cast<int>(tableName.size()), SQLITE_TRANSIENT);
+
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            hashes.emplace(std::bit_cast<uint64_t>(sqlite3_column_int64(stmt, 0)),
+                           std::bit_cast<uint64_t>(sqlite3_column_int64(stmt, 1)));
+        }
+    }
+
+    sqlite3_finalize(stmt);
+    return hashes;
+}
+
+std::vector<std::string> DeltaImporter::fetchKeyColumns(std::string_view tableName,
+                                                        std::span<const std::string> headers) const {
+    sqlite3_stmt* stmt = nullptr;
+    std::vector<std::pair<std::string, std::string>> uniqueIndexes;
+    const std::string query = "PRAGMA index_list(" + std::string(tableName) + ");";
+
+    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const auto* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+            const auto* origin = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+
+            if (name && sqlite3_column_int(stmt, 2) == 1) {
+                uniqueIndexes.emplace_back(name, origin ? origin : "");
+            }
+        }
+    }
+
+    sqlite3_finalize(stmt);
+
+    std::ranges::stable_partition(uniqueIndexes, [](const auto& index) { return index.second == "pk"; });
+
+    for (const auto& [indexName, _] : uniqueIndexes) {
+        auto columns = fetchIndexColumns(indexName);
+        const bool allPresent = !columns.empty() && std::ranges::all_of(columns, [&headers](const std::string& column) {
+            return std::ranges::find(headers, column) != headers.end();
+        });
+
+        if (allPresent) {
+            return columns;
+        }
+    }
+
+    return {headers.begin(), headers.end()};
+}
+
+std::vector<std::string> DeltaImporter::fetchIndexColumns(std::string_view indexName) const {
+    sqlite3_stmt* stmt = nullptr;
+    std::vector<std::string> columns;
+    const std::string query = "PRAGMA index_info(\"" + std::string(indexName) + "\");";
+
+    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const auto* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+            if (name) {
+                columns.emplace_back(name);
+            }
+        }
+    }
+
+    sqlite3_finalize(stmt);
+    return columns;
+}
+
+void DeltaImporter::storeRowHashes(std::string_view tableName, std::span<const RowHash> rows) {
+    sqlite3_stmt* stmt = nullptr;
+    const char* query = "INSERT OR REPLACE INTO dataset_row_hashes (table_name, key_hash, row_key, row_hash) "
+                        "VALUES (?, ?, ?, ?);";
+
+    if (sqlite3_prepare_v2(m_db, query, -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Failed to prepare row hash statement: " << sqlite3_errmsg(m_db) << std::endl;
+        return;
+    }
+
+    sqlite3_bind_text(stmt, 1, tableName.data(), static_cast<int>(tableName.size()), SQLITE_STATIC);
+
+    for (const auto& row : rows) {
+        sqlite3_bind_int64(stmt, 2, std::bit_cast<sqlite3_int64>(row.keyHash));
+        sqlite3_bind_text(stmt, 3, row.rowKey.data(), static_cast<int>(row.rowKey.size()), SQLITE_STATIC);
+        sqlite3_bind_int64(stmt, 4, std::bit_cast<sqlite3_int64>(row.rowHash));
+
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            std::cerr << "Failed to store row hash for " << tableName << ": " << sqlite3_errmsg(m_db) << std::endl;
+        }
+        sqlite3_reset(stmt);
+    }
+
+    sqlite3_finalize(stmt);
+}
+
+void DeltaImporter::recordReplacedRows(std::string_view tableName,
+                                       std::span<const std::string> keyColumns,
+                                       bool hasGameId,
+                                       TableDelta& delta) {
+    std::string whereClause;
+    for (size_t i = 0; i < keyColumns.size(); i++) {
+        whereClause += (i > 0 ? " AND \"" : "\"") + keyColumns[i] + "\" IS ?";
+    }
+
+    const std::string table(tableName);
+    const std::string live(DatasetPatch::LIVE_SCHEMA);
+    const std::string lookupQuery = "SELECT row_key FROM " + live + ".dataset_row_hashes WHERE table_name = ? AND key_hash = ?;";
+    const std::string findQuery = "SELECT rowid" + std::string(hasGameId ? ", game_id" : "") + " FROM " + live + "." + 
+                                  table + " WHERE " + whereClause + ";";
+    const std::string recordQuery = "INSERT OR IGNORE INTO " + std::string(DatasetPatch::REPLACED_ROWS_TABLE) + 
+                                    " (table_name, row_id, key_hash, deleted) VALUES (?, ?, ?, ?);";
+
+    sqlite3_stmt* lookupStmt = nullptr;
+    sqlite3_stmt* findStmt = nullptr;
+    sqlite3_stmt* recordStmt = nullptr;
+
+    const bool prepared = 
+        sqlite3_prepare_v2(m_db, lookupQuery.c_str(), -1, &lookupStmt, nullptr) == SQLITE_OK &&
+        sqlite3_prepare_v2(m_db, findQuery.c_str(), -1, &findStmt, nullptr) == SQLITE_OK &&
+        sqlite3_prepare_v2(m_db, recordQuery.c_str(), -1, &recordStmt, nullptr) == SQLITE_OK;
+
+    if (!prepared) {
+        std::cerr << "Failed to prepare replaced row statements for " << tableName << ": " << sqlite3_errmsg(m_db) << std::endl;
+        sqlite3_finalize(lookupStmt);
+        sqlite3_finalize(findStmt);
+        sqlite3_finalize(recordStmt);
+        delta.deletedKeys.clear();
+        return;
+    }
+
+    // Records the live rows stored under rowKey and returns how many there were.
+    auto recordRows = [&](std::string_view rowKey, uint64_t keyHash, bool deleted) -> size_t {
+        const auto keyValues = splitRowKey(rowKey);
+        if (keyValues.size() != keyColumns.size()) {
+            return 0;
+        }
+
+        for (size_t i = 0; i < keyValues.size(); i++) {
+            if (keyValues[i].empty()) {
+                sqlite3_bind_null(findStmt, static_cast<int>(i) + 1);
+            } else {
+                sqlite3_bind_text(findStmt, static_cast<int>(i) + 1, keyValues[i].data(), 
+                                  static_cast<int>(keyValues[i].size()), SQLITE_STATIC);
+            }
+        }
+
+        size_t recorded = 0;
+        while (sqlite3_step(findStmt) == SQLITE_ROW) {
+            if (hasGameId && sqlite3_column_type(findStmt, 1) != SQLITE_NULL) {
+                delta.touchedGameIds.push_back(sqlite3_column_int(findStmt, 1));
+            }
+
+            sqlite3_bind_text(recordStmt, 1, table.data(), static_cast<int>(table.size()), SQLITE_STATIC);
+            sqlite3_bind_int64(recordStmt, 2, sqlite3_column_int64(findStmt, 0));
+            sqlite3_bind_int64(recordStmt, 3, std::bit_cast<sqlite3_int64>(keyHash));
+            sqlite3_bind_int(recordStmt, 4, deleted ? 1 : 0);
+
+            if (sqlite3_step(recordStmt) == SQLITE_DONE) {
+                recorded += static_cast<size_t>(sqlite3_changes(m_db));
+            }
+            sqlite3_reset(recordStmt);
+        }
+        sqlite3_reset(findStmt);
+
+        return recorded;
+    };
+
+    for (const auto& row : delta.changedRows) {
+        if (row.replacesRow) {
+            recordRows(row.rowKey, row.keyHash, false);
+        }
+    }
+
+    for (uint64_t keyHash : delta.deletedKeys) {
+        sqlite3_bind_text(lookupStmt, 1, table.data(), static_cast<int>(table.size()), SQLITE_STATIC);
+        sqlite3_bind_int64(lookupStmt, 2, std::bit_cast<sqlite3_int64>(keyHash));
+
+        std::string rowKey;
+        if (sqlite3_step(lookupStmt) == SQLITE_ROW) {
+            const auto* storedKey = reinterpret_cast<const char*>(sqlite3_column_text(lookupStmt, 0));
+            rowKey = storedKey ? storedKey : "";
+        }
+        sqlite3_reset(lookupStmt);
+
+        delta.changes.deleted += recordRows(rowKey, keyHash, true);
+    }
+
+    sqlite3_finalize(lookupStmt);
+    sqlite3_finalize(findStmt);
+    sqlite3_finalize(recordStmt);
+}
+
+bool DeltaImporter::execute(const std::string& sql) const {
+    char* errMsg = nullptr;
+    if (sqlite3_exec(m_db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "SQL error: " << errMsg << std::endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
+    return true;
+}
+
+uint64_t DeltaImporter::hashBytes(std::string_view bytes, uint64_t seed) noexcept {
+    uint64_t hash = seed;
+    for (const char c : bytes) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+std::vector<std::string_view> DeltaImporter::splitRowKey(std::string_view rowKey) {
+    std::vector<std::string_view> values;
+    size_t start = 0;
+
+    while (true) {
+        const size_t end = rowKey.find(KEY_SEPARATOR, start);
+        values.push_back(rowKey.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start));
+
+        if (end == std::string_view::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+
+    return values;
+}
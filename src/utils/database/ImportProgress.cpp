@@ -0,0 +1,186 @@
+#include "utils/database/ImportProgress.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+    constexpr double BYTES_PER_MB = 1024.0 * 1024.0;
+
+    double smooth(double current, double sample, double weight) {
+        return current == 0.0 ? sample : current + weight * (sample - current);
+    }
+
+    std::string formatCount(double value) {
+        char buffer[32];
+        if (value >= 1e6) {
+            std::snprintf(buffer, sizeof(buffer), "%.1fM", value / 1e6);
+        } else if (value >= 1e3) {
+            std::snprintf(buffer, sizeof(buffer), "%.0fk", value / 1e3);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%.0f", value);
+        }
+        return buffer;
+    }
+
+}
+
+ImportProgress::ImportProgress(ProgressCallback progressCallback, int baseProgress, int progressRange)
+    : m_progressCallback(std::move(progressCallback))
+    , m_baseProgress(baseProgress)
+    , m_progressRange(progressRange)
+    , m_startTime(std::chrono::steady_clock::now())
+    , m_lastSample(m_startTime) {
+    m_reporter = std::thread([this]() { run(); });
+}
+
+ImportProgress::~ImportProgress() {
+    stop();
+}
+
+void ImportProgress::setStatus(std::string status) {
+    std::lock_guard lock(m_mutex);
+    m_status = std::move(status);
+}
+
+ProgressCallback ImportProgress::statusCallback() {
+    return [this](const std::string& status, int) { setStatus(status); };
+}
+
+void ImportProgress::addExpectedBytes(Stage stage, uint64_t bytes) noexcept {
+    counters(stage).expected += bytes;
+}
+
+void ImportProgress::setExpectedBytes(Stage stage, uint64_t bytes) noexcept {
+    counters(stage).expected = bytes;
+}
+
+void ImportProgress::addProcessedBytes(Stage stage, uint64_t bytes) noexcept {
+    counters(stage).processed += bytes;
+}
+
+void ImportProgress::setProcessedBytes(Stage stage, uint64_t bytes) noexcept {
+    counters(stage).processed = bytes;
+}
+
+void ImportProgress::addRows(uint64_t rows) noexcept {
+    m_rows += rows;
+}
+
+ImportTelemetry ImportProgress::stop() {
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_stopped) {
+            return m_telemetry;
+        }
+        m_stopped = true;
+    }
+
+    m_wake.notify_all();
+    if (m_reporter.joinable()) {
+        m_reporter.join();
+    }
+
+    sample();
+    std::cout << "Import telemetry: " << formatSummary(m_telemetry) << std::endl;
+    return m_telemetry;
+}
+
+void ImportProgress::run() {
+    std::unique_lock lock(m_mutex);
+
+    while (!m_wake.wait_for(lock, REPORT_INTERVAL, [this]() { return m_stopped; })) {
+        lock.unlock();
+        sample();
+        report();
+        lock.lock();
+    }
+}
+
+void ImportProgress::sample() {
+    const auto now = std::chrono::steady_clock::now();
+    const double interval = std::chrono::duration<double>(now - m_lastSample).count();
+
+    auto& download = counters(Stage::Download);
+    auto& parse = counters(Stage::Parse);
+
+    m_telemetry.bytesDownloaded = download.processed;
+    m_telemetry.downloadExpected = download.expected;
+    m_telemetry.bytesParsed = parse.processed;
+    m_telemetry.bytesExpected = parse.expected;
+    m_telemetry.rowsParsed = m_rows;
+    m_telemetry.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_startTime);
+
+    const uint64_t processed = std::min(m_telemetry.bytesDownloaded, m_telemetry.downloadExpected) +
+                               std::min(m_telemetry.bytesParsed, m_telemetry.bytesExpected);
+    const uint64_t expected = m_telemetry.downloadExpected + m_telemetry.bytesExpected;
+
+    if (expected > 0) {
+        m_telemetry.fraction = std::max(m_lastFraction, static_cast<double>(processed) / static_cast<double>(expected));
+    }
+
+    if (interval > 0.0) {
+        m_telemetry.bytesPerSecond = smooth(m_telemetry.bytesPerSecond,
+                                            static_cast<double>(m_telemetry.bytesParsed - m_lastBytes) / interval,
+                                            RATE_SMOOTHING);
+        m_telemetry.rowsPerSecond = smooth(m_telemetry.rowsPerSecond,
+                                           static_cast<double>(m_telemetry.rowsParsed - m_lastRows) / interval,
+                                           RATE_SMOOTHING);
+        m_fractionRate = smooth(m_fractionRate, (m_telemetry.fraction - m_lastFraction) / interval, RATE_SMOOTHING);
+    }
+
+    m_telemetry.eta.reset();
+    if (m_fractionRate > 0.0 && m_telemetry.fraction < 1.0) {
+        m_telemetry.eta = std::chrono::seconds(static_cast<int64_t>((1.0 - m_telemetry.fraction) / m_fractionRate));
+    }
+
+    m_lastSample = now;
+    m_lastBytes = m_telemetry.bytesParsed;
+    m_lastRows = m_telemetry.rowsParsed;
+    m_lastFraction = m_telemetry.fraction;
+}
+
+void ImportProgress::report() {
+    if (!m_progressCallback) {
+        return;
+    }
+
+    std::string status;
+    {
+        std::lock_guard lock(m_mutex);
+        status = m_status;
+    }
+
+    const int progress = m_baseProgress + static_cast<int>(m_telemetry.fraction * m_progressRange);
+    m_progressCallback(status + "\n" + formatRate(m_telemetry), progress);
+}
+
+std::string ImportProgress::formatRate(const ImportTelemetry& telemetry) {
+    std::string text = formatCount(telemetry.rowsPerSecond) + " rows/s";
+
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), ", %.1f MB/s", telemetry.bytesPerSecond / BYTES_PER_MB);
+    text += buffer;
+
+    if (telemetry.eta) {
+        const auto seconds = telemetry.eta->count();
+        std::snprintf(buffer, sizeof(buffer), ", %lld:%02lld left",
+                      static_cast<long long>(seconds / 60), static_cast<long long>(seconds % 60));
+        text += buffer;
+    }
+
+    return text;
+}
+
+std::string ImportProgress::formatSummary(const ImportTelemetry& telemetry) {
+    const double seconds = std::max(telemetry.elapsed.count() / 1000.0, 0.001);
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), "%.1f MB downloaded, %.1f MB parsed, %llu rows in %.1f s (%.1f MB/s, %s rows/s)",
+                  telemetry.bytesDownloaded / BYTES_PER_MB,
+                  telemetry.bytesParsed / BYTES_PER_MB,
+                  static_cast<unsigned long long>(telemetry.rowsParsed),
+                  seconds,
+                  telemetry.bytesParsed / BYTES_PER_MB / seconds,
+                  formatCount(telemetry.rowsParsed / seconds).c_str());
+    return buffer;
+}
@@ -0,0 +1,75 @@
+#include "utils/database/NameSearch.h"
+#include <iostream>
+#include <string>
+
+namespace {
+
+    std::string_view trim(std::string_view text) {
+        const auto first = text.find_first_not_of(" \t\r\n");
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        return text.substr(first, text.find_last_not_of(" \t\r\n") - first + 1);
+    }
+
+    size_t codePointCount(std::string_view text) {
+        size_t count = 0;
+        for (const unsigned char c : text) {
+            count += (c & 0xC0) != 0x80;
+        }
+        return count;
+    }
+
+    std::string quotePhrase(std::string_view text) {
+        std::string phrase = "\"";
+        for (const char c : text) {
+            phrase += c;
+            if (c == '"') {
+                phrase += '"';
+            }
+        }
+        return phrase + "\"";
+    }
+
+    std::string likePattern(std::string_view text) {
+        std::string pattern = "%";
+        for (const char c : text) {
+            if (c == '%' || c == '_' || c == '\\') {
+                pattern += '\\';
+            }
+            pattern += c;
+        }
+        return pattern + "%";
+    }
+
+}
+
+std::vector<int> NameSearch::search(StatementCache& statements, std::string_view indexTable, std::string_view text) {
+    std::vector<int> ids;
+    text = trim(text);
+
+    if (text.empty()) {
+        return ids;
+    }
+
+    const std::string table(indexTable);
+    const bool useIndex = codePointCount(text) >= TRIGRAM_LENGTH;
+    const std::string query = useIndex
+        ? "SELECT rowid FROM " + table + " WHERE " + table + " MATCH ? ORDER BY rank"
+        : "SELECT rowid FROM " + table + " WHERE name LIKE ? ESCAPE '\\' ORDER BY length(name)";
+    const std::string argument = useIndex ? quotePhrase(text) : likePattern(text);
+
+    auto stmt = statements.acquire(query);
+    if (!stmt) {
+        std::cerr << "SQL error: " << sqlite3_errmsg(statements.connection()) << std::endl;
+        return ids;
+    }
+
+    sqlite3_bind_text(stmt, 1, argument.c_str(), static_cast<int>(argument.size()), SQLITE_TRANSIENT);
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        ids.push_back(sqlite3_column_int(stmt, 0));
+    }
+
+    return ids;
+}
@@ -0,0 +1,380 @@
+#include "utils/database/ParallelImporter.h"
+#include "utils/database/ImportProgress.h"
+#include "utils/BoundedQueue.h"
+#include "utils/ZipArchive.h"
+#include <iostream>
+#include <algorithm>
+#include <numeric>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+ParallelImporter::ParallelImporter(sqlite3* db, fs::path stagingDirectory, unsigned maxConcurrentTables)
+    : m_db(db)
+    , m_stagingDirectory(std::move(stagingDirectory))
+    , m_maxConcurrentTables(maxConcurrentTables > 0 
+        ? maxConcurrentTables 
+        : std::max(1u, std::thread::hardware_concurrency() / 2)) {
+}
+
+std::vector<ImportStats> ParallelImporter::importTables(std::span<const ImportSource> sources,
+                                                        const ProgressCallback& progressCallback,
+                                                        int baseProgress,
+                                                        int progressRange) {
+    const auto startTime = std::chrono::steady_clock::now();
+    std::vector<ImportStats> results(sources.size());
+
+    if (sources.empty()) {
+        return results;
+    }
+
+    std::error_code ec;
+    fs::create_directories(m_stagingDirectory, ec);
+    if (ec) {
+        std::cerr << "Failed to create staging directory " << m_stagingDirectory << ": " << ec.message() << std::endl;
+        return results;
+    }
+
+    std::vector<std::string> createStatements;
+    createStatements.reserve(sources.size());
+    for (const auto& source : sources) {
+        createStatements.push_back(fetchCreateStatement(source.tableName));
+    }
+
+    std::vector<uint64_t> sizes;
+    sizes.reserve(sources.size());
+    for (const auto& source : sources) {
+        sizes.push_back(CSVSource::sourceSize(source));
+    }
+
+    if (m_progress) {
+        m_progress->addExpectedBytes(ImportProgress::Stage::Parse, std::accumulate(sizes.begin(), sizes.end(), uint64_t{0}));
+    }
+
+    std::vector<size_t> order(sources.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, std::greater{}, [&sizes](size_t idx) {
+        return sizes[idx];
+    });
+
+    std::atomic<size_t> nextJob{0};
+    BoundedQueue<size_t> completed(sources.size());
+
+    const unsigned workerCount = std::min<unsigned>(m_maxConcurrentTables, static_cast<unsigned>(sources.size()));
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+
+    for (unsigned w = 0; w < workerCount; w++) {
+        workers.emplace_back([&]() {
+            for (size_t job = nextJob++; job < order.size(); job = nextJob++) {
+                const size_t idx = order[job];
+
+                if (!createStatements[idx].empty()) {
+                    CSVSource csv(sources[idx]);
+                    csv.setProgress(m_progress);
+                    results[idx] = importIntoStaging(sources[idx].tableName, csv, createStatements[idx], 
+                                                     stagingPath(sources[idx].tableName));
+                } else {
+                    std::cerr << "Table " << sources[idx].tableName << " is missing from the schema. Skipping it." << std::endl;
+                    results[idx].tableName = sources[idx].tableName;
+                }
+
+                completed.push(idx);
+            }
+        });
+    }
+
+    for (size_t merged = 0; merged < sources.size(); merged++) {
+        const auto idx = completed.pop();
+        if (!idx) {
+            break;
+        }
+
+        const auto& source = sources[*idx];
+        mergeResult(results[*idx], !createStatements[*idx].empty());
+
+        if (progressCallback) {
+            progressCallback("Loaded " + source.tableName + " data (" + std::to_string(results[*idx].rowsImported) + " rows)",
+                             baseProgress + static_cast<int>((merged + 1) * progressRange / sources.size()));
+        }
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::error_code removeError;
+    fs::remove(m_stagingDirectory, removeError);
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+    std::cout << "Imported " << sources.size() << " tables using " << workerCount 
+              << " parallel workers in " << elapsed.count() << " ms" << std::endl;
+
+    return results;
+}
+
+std::vector<ImportStats> ParallelImporter::importStream(ZipStreamReader& entries,
+                                                        std::span<const std::string> tableNames,
+                                                        const ProgressCallback& progressCallback,
+                                                        int baseProgress,
+                                                        int progressRange) {
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::error_code ec;
+    fs::create_directories(m_stagingDirectory, ec);
+    if (ec) {
+        std::cerr << "Failed to create staging directory " << m_stagingDirectory << ": " << ec.message() << std::endl;
+        while (auto entry = entries.nextEntry()) {
+            entry->data->cancel();
+        }
+        return {};
+    }
+
+    std::unordered_map<std::string, std::string> createStatements;
+    for (const auto& tableName : tableNames) {
+        createStatements.emplace(tableName, fetchCreateStatement(tableName));
+    }
+
+    std::deque<ImportStats> results;
+    std::mutex resultsMutex;
+    BoundedQueue<size_t> completed(ZipStreamReader::MAX_PENDING_ENTRIES);
+
+    // Entries are taken in archive order, so every entry a worker holds has either
+    // been fully inflated or is the one being inflated right now.
+    const unsigned workerCount = std::max(1u, std::min<unsigned>(m_maxConcurrentTables,
+                                                                  static_cast<unsigned>(tableNames.size())));
+    std::atomic<unsigned> runningWorkers{workerCount};
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount);
+
+    for (unsigned w = 0; w < workerCount; w++) {
+        workers.emplace_back([&]() {
+            while (auto entry = entries.nextEntry()) {
+                const std::string tableName = fs::path(entry->name).stem().string();
+                size_t idx = 0;
+                {
+                    std::lock_guard lock(resultsMutex);
+                    idx = results.size();
+                    results.push_back({tableName});
+                }
+
+                if (m_progress) {
+                    m_progress->addExpectedBytes(ImportProgress::Stage::Parse, entry->uncompressedSize);
+                }
+
+                CSVSource csv(entry->name, entry->data);
+                csv.setProgress(m_progress);
+                const auto createIt = createStatements.find(tableName);
+                ImportStats stats{tableName};
+
+                if (createIt != createStatements.end() && !createIt->second.empty()) {
+                    stats = importIntoStaging(tableName, csv, createIt->second, stagingPath(tableName));
+                } else {
+                    std::cerr << "Table " << tableName << " is missing from the schema. Skipping it." << std::endl;
+                }
+
+                {
+                    std::lock_guard lock(resultsMutex);
+                    results[idx] = std::move(stats);
+                }
+                completed.push(idx);
+            }
+
+            if (--runningWorkers == 0) {
+                completed.close();
+            }
+        });
+    }
+
+    size_t merged = 0;
+    while (const auto idx = completed.pop()) {
+        ImportStats stats;
+        {
+            std::lock_guard lock(resultsMutex);
+            stats = results[*idx];
+        }
+
+        const auto createIt = createStatements.find(stats.tableName);
+        mergeResult(stats, createIt != createStatements.end() && !createIt->second.empty());
+        merged++;
+
+        if (progressCallback) {
+            const size_t expected = std::max(tableNames.size(), merged);
+            progressCallback("Loaded " + stats.tableName + " data (" + std::to_string(stats.rowsImported) + " rows)",
+                             baseProgress + static_cast<int>(merged * progressRange / expected));
+        }
+
+        std::lock_guard lock(resultsMutex);
+        results[*idx] = std::move(stats);
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (entries.failed()) {
+        std::cerr << "Dataset archive stream was incomplete. Tables that arrived intact were imported." << std::endl;
+    }
+
+    std::error_code removeError;
+    fs::remove(m_stagingDirectory, removeError);
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+    std::cout << "Imported " << merged << " tables using " << workerCount
+              << " parallel workers while streaming the dataset archive in " << elapsed.count() << " ms" << std::endl;
+
+    return {results.begin(), results.end()};
+}
+
+void ParallelImporter::mergeResult(ImportStats& stats, bool inSchema) {
+    if (stats.failed) {
+        std::cerr << "Import of " << stats.tableName << " failed. Keeping existing data." << std::endl;
+        stats.rowsImported = 0;
+        removeStagingFiles(stagingPath(stats.tableName));
+    } else if (inSchema && !mergeStaging(stats.tableName, stagingPath(stats.tableName))) {
+        stats.rowsImported = 0;
+    }
+}
+
+ImportStats ParallelImporter::importIntoStaging(std::string_view tableName,
+                                                CSVSource& source,
+                                                const std::string& createStatement,
+                                                const fs::path& path) {
+    removeStagingFiles(path);
+
+    sqlite3* stagingDb = nullptr;
+    const int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX;
+
+    if (sqlite3_open_v2(path.string().c_str(), &stagingDb, flags, nullptr) != SQLITE_OK) {
+        std::cerr << "Can't open staging database for " << tableName << ": " << sqlite3_errmsg(stagingDb) << std::endl;
+        sqlite3_close(stagingDb);
+        return {std::string(tableName), 0, 0, {}, true};
+    }
+
+    const std::string setup = "PRAGMA journal_mode=WAL; PRAGMA synchronous=OFF; PRAGMA temp_store=MEMORY; " 
+                              "PRAGMA cache_size=-" + std::to_string(STAGING_CACHE_SIZE_KIB) + "; " + createStatement + ";";
+    char* errMsg = nullptr;
+
+    if (sqlite3_exec(stagingDb, setup.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "Failed to prepare staging table " << tableName << ": " << errMsg << std::endl;
+        sqlite3_free(errMsg);
+        sqlite3_close(stagingDb);
+        return {std::string(tableName), 0, 0, {}, true};
+    }
+
+    CSVImporter importer(stagingDb);
+    ImportStats stats = importer.importFrom(tableName, source);
+
+    sqlite3_close(stagingDb);
+    return stats;
+}
+
+bool ParallelImporter::mergeStaging(std::string_view tableName, const fs::path& path) {
+    sqlite3_stmt* stmt = nullptr;
+    bool attached = false;
+
+    if (sqlite3_prepare_v2(m_db, "ATTACH DATABASE ? AS staging;", -1, &stmt, nullptr) == SQLITE_OK) {
+        const std::string stagingFile = path.string();
+        sqlite3_bind_text(stmt, 1, stagingFile.c_str(), -1, SQLITE_TRANSIENT);
+        attached = sqlite3_step(stmt) == SQLITE_DONE;
+    }
+    sqlite3_finalize(stmt);
+
+    if (!attached) {
+        std::cerr << "Failed to attach staging database for " << tableName << ": " << sqlite3_errmsg(m_db) << std::endl;
+        removeStagingFiles(path);
+        return false;
+    }
+
+    const std::string table(tableName);
+    bool merged = false;
+
+    if (execute("BEGIN TRANSACTION;")) {
+        const auto primaryKey = fetchPrimaryKeyColumns(tableName);
+        const std::string orderBy = primaryKey.empty() ? "" : " ORDER BY " + primaryKey;
+
+        merged = execute("INSERT OR REPLACE INTO main." + table + " SELECT * FROM staging." + table + orderBy + ";") &&
+                 execute("COMMIT;");
+
+        if (!merged) {
+            execute("ROLLBACK;");
+        }
+    }
+
+    execute("DETACH DATABASE staging;");
+    removeStagingFiles(path);
+
+    return merged;
+}
+
+std::string ParallelImporter::fetchCreateStatement(std::string_view tableName) const {
+    sqlite3_stmt* stmt = nullptr;
+    std::string createStatement;
+    const char* query = "SELECT sql FROM sqlite_master WHERE type='table' AND name=?;";
+
+    if (sqlite3_prepare_v2(m_db, query, -1, &stmt, nullptr) == SQLITE_OK) {
+        sqlite3_bind_text(stmt, 1, tableName.data(), static_cast<int>(tableName.size()), SQLITE_TRANSIENT);
+
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            const auto* sql = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+            createStatement = sql ? sql : "";
+        }
+    }
+
+    sqlite3_finalize(stmt);
+    return createStatement;
+}
+
+std::string ParallelImporter::fetchPrimaryKeyColumns(std::string_view tableName) const {
+    sqlite3_stmt* stmt = nullptr;
+    std::vector<std::pair<int, std::string>> keyColumns;
+    const std::string query = "PRAGMA main.table_info(" + std::string(tableName) + ");";
+
+    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) == SQLITE_OK) {
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const int keyPosition = sqlite3_column_int(stmt, 5);
+            const auto* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+
+            if (keyPosition > 0 && name) {
+                keyColumns.emplace_back(keyPosition, name);
+            }
+        }
+    }
+
+    sqlite3_finalize(stmt);
+    std::ranges::sort(keyColumns);
+
+    std::string columns;
+    for (const auto& [_, name] : keyColumns) {
+        columns += (columns.empty() ? "\"" : ", \"") + name + "\"";
+    }
+    return columns;
+}
+
+fs::path ParallelImporter::stagingPath(std::string_view tableName) const {
+    return m_stagingDirectory / (std::string(tableName) + ".db");
+}
+
+bool ParallelImporter::execute(const std::string& sql) const {
+    char* errMsg = nullptr;
+    if (sqlite3_exec(m_db, sql.c_str(), nullptr, nullptr, &errMsg) != SQLITE_OK) {
+        std::cerr << "SQL error: " << errMsg << std::endl;
+        sqlite3_free(errMsg);
+        return false;
+    }
+    return true;
+}
+
+void ParallelImporter::removeStagingFiles(const fs::path& path) {
+    std::error_code ec;
+    fs::remove(path, ec);
+    fs::remove(fs::path(path.string() + "-wal"), ec);
+    fs::remove(fs::path(path.string() + "-shm"), ec);
+}
@@ -1,4 +1,5 @@
 #include "utils/database/PlayerMapper.h"
+#include "utils/DayDate.h"
 #include <string>
 
 Player PlayerMapper::mapPlayerFromStatement(sqlite3_stmt* stmt) {
@@ -9,7 +10,7 @@ Player PlayerMapper::mapPlayerFromStatement(sqlite3_stmt* stmt) {
     player.clubName = extractTextColumn(stmt, 3);
     player.subPosition = extractTextColumn(stmt, 4);
     player.position = extractTextColumn(stmt, 5);
-    player.contractExpirationDate = extractTextColumn(stmt, 6);
+    player.contractExpirationDate = formatDayNumber(extractIntColumn(stmt, 6));
     player.marketValue = extractIntColumn(stmt, 7);
     player.highestMarketValue = extractIntColumn(stmt, 8);
     player.imageUrl = extractTextColumn(stmt, 9);
@@ -29,13 +30,15 @@ std::optional<Player> PlayerMapper::tryMapPlayerFromStatement(sqlite3_stmt* stmt
     }
 }
 
-std::string PlayerMapper::extractTextColumn(sqlite3_stmt* stmt, int columnIndex) {
+PooledString PlayerMapper::extractTextColumn(sqlite3_stmt* stmt, int columnIndex) {
     if (isColumnNull(stmt, columnIndex)) {
         return {};
     }
     
+    // Interned straight from the column buffer, so no temporary std::string is built.
     const unsigned char* text = sqlite3_column_text(stmt, columnIndex);
-    return text ? std::string(reinterpret_cast<const char*>(text)) : std::string{};
+    const int size = sqlite3_column_bytes(stmt, columnIndex);
+    return text ? PooledString(std::string_view(reinterpret_cast<const char*>(text), static_cast<size_t>(size))) : PooledString{};
 }
 
 int PlayerMapper::extractIntColumn(sqlite3_stmt* stmt, int columnIndex) {
@@ -0,0 +1,255 @@
+#include "utils/database/QueryPlanAuditor.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+    bool isAuditable(std::string_view sql) {
+        const auto first = sql.find_first_not_of(" \t\r\n");
+        if (first == std::string_view::npos) {
+            return false;
+        }
+
+        std::string keyword;
+        for (const char c : sql.substr(first, 7)) {
+            keyword += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+        return keyword.starts_with("SELECT") || keyword.starts_with("WITH") ||
+               keyword.starts_with("UPDATE") || keyword.starts_with("DELETE") || keyword.starts_with("INSERT");
+    }
+
+    std::string collapseWhitespace(std::string_view sql) {
+        std::string collapsed;
+        bool pendingSpace = false;
+
+        for (const char c : sql) {
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                pendingSpace = !collapsed.empty();
+                continue;
+            }
+            if (pendingSpace) {
+                collapsed += ' ';
+                pendingSpace = false;
+            }
+            collapsed += c;
+        }
+        return collapsed;
+    }
+
+    constexpr std::array<std::string_view, 24> CLAUSE_KEYWORDS{
+        "where", "join", "inner", "left", "right", "full", "outer", "cross", "natural", "on",
+        "using", "group", "order", "limit", "union", "except", "intersect", "set", "values",
+        "indexed", "not", "window", "having", "returning"
+    };
+
+    bool isIdentifierChar(char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.';
+    }
+
+    // Lowercased identifiers and punctuation of sql. String literals are dropped and
+    // quoted identifiers lose their quotes.
+    std::vector<std::string> tokenize(std::string_view sql) {
+        std::vector<std::string> tokens;
+        size_t i = 0;
+
+        while (i < sql.size()) {
+            const char c = sql[i];
+
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                ++i;
+            } else if (c == '\'') {
+                const auto end = sql.find('\'', i + 1);
+                i = end == std::string_view::npos ? sql.size() : end + 1;
+            } else if (c == '"' || c == '`') {
+                const auto end = sql.find(c, i + 1);
+                const auto last = end == std::string_view::npos ? sql.size() : end;
+                std::string token(sql.substr(i + 1, last - i - 1));
+                std::ranges::transform(token, token.begin(), [](unsigned char ch) { return std::tolower(ch); });
+                tokens.push_back(std::move(token));
+                i = last + 1;
+            } else if (isIdentifierChar(c)) {
+                std::string token;
+                for (; i < sql.size() && isIdentifierChar(sql[i]); ++i) {
+                    token += static_cast<char>(std::tolower(static_cast<unsigned char>(sql[i])));
+                }
+                tokens.push_back(std::move(token));
+            } else {
+                tokens.emplace_back(1, c);
+                ++i;
+            }
+        }
+        return tokens;
+    }
+
+    bool isAlias(std::string_view token) {
+        return !token.empty() && (std::isalpha(static_cast<unsigned char>(token.front())) || token.front() == '_') &&
+               std::ranges::find(CLAUSE_KEYWORDS, token) == CLAUSE_KEYWORDS.end();
+    }
+
+    std::string_view largeTable(std::string_view token) {
+        const auto dot = token.rfind('.');
+        const auto name = dot == std::string_view::npos ? token : token.substr(dot + 1);
+        const auto it = std::ranges::find(QueryPlanAuditor::LARGE_TABLES, name);
+        return it == QueryPlanAuditor::LARGE_TABLES.end() ? std::string_view{} : *it;
+    }
+
+    // Large tables by the name the query plan prints for them: their own name and
+    // every alias the statement gives them. SQLite 3.36+ reports aliased tables as
+    // "SCAN p" rather than "SCAN TABLE players_compact AS p".
+    std::unordered_map<std::string, std::string_view> largeTableNames(std::string_view sql) {
+        std::unordered_map<std::string, std::string_view> names;
+        for (const auto table : QueryPlanAuditor::LARGE_TABLES) {
+            names.emplace(table, table);
+        }
+
+        const auto tokens = tokenize(sql);
+        for (size_t i = 0; i + 1 < tokens.size(); ++i) {
+            const auto table = largeTable(tokens[i]);
+            if (table.empty()) {
+                continue;
+            }
+
+            const size_t aliasIndex = tokens[i + 1] == "as" ? i + 2 : i + 1;
+            if (aliasIndex < tokens.size() && isAlias(tokens[aliasIndex])) {
+                names.emplace(tokens[aliasIndex], table);
+            }
+        }
+        return names;
+    }
+
+    // The table or alias of a "SCAN <name>", "SCAN <name> AS <alias>" or, before
+    // SQLite 3.36, "SCAN TABLE <name>" plan row. A trailing alias wins over the name.
+    std::string scannedName(std::string_view detail) {
+        constexpr std::string_view SCAN_PREFIX = "SCAN ";
+        constexpr std::string_view TABLE_PREFIX = "TABLE ";
+        constexpr std::string_view ALIAS_SEPARATOR = " AS ";
+        if (!detail.starts_with(SCAN_PREFIX)) {
+            return {};
+        }
+
+        detail.remove_prefix(SCAN_PREFIX.size());
+        if (detail.starts_with(TABLE_PREFIX)) {
+            detail.remove_prefix(TABLE_PREFIX.size());
+        }
+
+        std::string_view name = detail.substr(0, detail.find(' '));
+        if (detail.substr(name.size()).starts_with(ALIAS_SEPARATOR)) {
+            const auto alias = detail.substr(name.size() + ALIAS_SEPARATOR.size());
+            name = alias.substr(0, alias.find(' '));
+        }
+
+        std::string lowered(name);
+        std::ranges::transform(lowered, lowered.begin(), [](unsigned char ch) { return std::tolower(ch); });
+        return lowered;
+    }
+
+}
+
+QueryPlanAuditor::QueryPlanAuditor(sqlite3* db)
+    : m_db(db) {
+    watch(m_db);
+}
+
+void QueryPlanAuditor::watch(sqlite3* db) {
+    sqlite3_trace_v2(db, SQLITE_TRACE_PROFILE, &QueryPlanAuditor::traceCallback, this);
+}
+
+QueryPlanAuditor::~QueryPlanAuditor() {
+    sqlite3_trace_v2(m_db, 0, nullptr, nullptr);
+}
+
+bool QueryPlanAuditor::isEnabled() {
+    const char* value = std::getenv(ENVIRONMENT_VARIABLE);
+    return value && *value && std::string_view(value) != "0";
+}
+
+int QueryPlanAuditor::traceCallback(unsigned type, void* context, void* statement, void* elapsed) {
+    if (type != SQLITE_TRACE_PROFILE) {
+        return 0;
+    }
+
+    const char* sql = sqlite3_sql(static_cast<sqlite3_stmt*>(statement));
+    if (sql && isAuditable(sql)) {
+        const auto nanoseconds = std::chrono::nanoseconds(*static_cast<sqlite3_int64*>(elapsed));
+        static_cast<QueryPlanAuditor*>(context)->record(sql, nanoseconds);
+    }
+    return 0;
+}
+
+void QueryPlanAuditor::record(std::string sql, std::chrono::nanoseconds elapsed) {
+    std::lock_guard lock(m_mutex);
+    auto& timing = m_timings[std::move(sql)];
+    timing.executions++;
+    timing.totalTime += elapsed;
+    timing.maxTime = std::max(timing.maxTime, elapsed);
+}
+
+std::vector<FullScan> QueryPlanAuditor::findFullScans(sqlite3* db, std::string_view sql) {
+    std::vector<FullScan> fullScans;
+    const std::string query = "EXPLAIN QUERY PLAN " + std::string(sql);
+    sqlite3_stmt* stmt = nullptr;
+
+    if (sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK) {
+        sqlite3_finalize(stmt);
+        return fullScans;
+    }
+
+    const auto tables = largeTableNames(sql);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+        const std::string_view detail = text ? text : "";
+
+        if (const auto it = tables.find(scannedName(detail)); it != tables.end()) {
+            fullScans.push_back({std::string(it->second), std::string(detail)});
+        }
+    }
+
+    sqlite3_finalize(stmt);
+    return fullScans;
+}
+
+void QueryPlanAuditor::clear() {
+    std::lock_guard lock(m_mutex);
+    m_timings.clear();
+}
+
+std::vector<QueryAuditEntry> QueryPlanAuditor::report() const {
+    std::vector<QueryAuditEntry> entries;
+    {
+        std::lock_guard lock(m_mutex);
+        entries.reserve(m_timings.size());
+        for (const auto& [sql, timing] : m_timings) {
+            entries.push_back({sql, timing.executions, timing.totalTime, timing.maxTime, {}});
+        }
+    }
+
+    for (auto& entry : entries) {
+        entry.fullScans = findFullScans(m_db, entry.sql);
+    }
+
+    std::ranges::sort(entries, std::ranges::greater{}, &QueryAuditEntry::totalTime);
+    return entries;
+}
+
+bool QueryPlanAuditor::printReport() const {
+    const auto entries = report();
+    bool clean = true;
+
+    std::cout << "Query audit: " << entries.size() << " distinct statements" << std::endl;
+
+    for (const auto& entry : entries) {
+        const auto total = std::chrono::duration_cast<std::chrono::microseconds>(entry.totalTime);
+        const auto max = std::chrono::duration_cast<std::chrono::microseconds>(entry.maxTime);
+        std::cout << "  " << entry.executions << "x, " << total.count() << " us total, " << max.count()
+                  << " us max: " << collapseWhitespace(entry.sql) << std::endl;
+
+        for (const auto& scan : entry.fullScans) {
+            std::cerr << "    Full scan of " << scan.table << ": " << scan.detail << std::endl;
+            clean = false;
+        }
+    }
+
+    return clean;
+}
@@ -0,0 +1,262 @@
+#include "utils/database/ReplayCache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    constexpr size_t alignUp(size_t offset, size_t alignment) {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    uint8_t narrow(int value) {
+        return static_cast<uint8_t>(std::clamp(value, 0, 255));
+    }
+
+    template<typename T>
+    void appendColumn(std::string& out, const std::vector<T>& column, size_t alignment) {
+        out.append(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+        out.resize(alignUp(out.size(), alignment), '\0');
+    }
+
+    template<typename T>
+    bool takeColumn(std::string_view file, size_t& offset, size_t count, size_t alignment, std::span<const T>& column) {
+        const size_t bytes = count * sizeof(T);
+        if (offset + bytes > file.size()) {
+            return false;
+        }
+
+        column = {reinterpret_cast<const T*>(file.data() + offset), count};
+        offset = alignUp(offset + bytes, alignment);
+        return true;
+    }
+
+}
+
+std::string_view ReplayColumns::clubName(int32_t clubId) const {
+    const auto it = std::ranges::lower_bound(nameClubIds, clubId);
+    if (it == nameClubIds.end() || *it != clubId) {
+        return "Unknown";
+    }
+
+    const auto index = static_cast<size_t>(it - nameClubIds.begin());
+    return nameData.substr(nameOffsets[index], nameOffsets[index + 1] - nameOffsets[index]);
+}
+
+ReplayCache::ReplayCache(const fs::path& path, int64_t datasetVersion) {
+    std::error_code ec;
+    if (!fs::is_regular_file(path, ec)) {
+        return;
+    }
+
+    m_file = std::make_unique<MappedFile>(path.string());
+    if (!m_file->isOpen() || m_file->size() < sizeof(Header)) {
+        return;
+    }
+
+    Header header;
+    std::memcpy(&header, m_file->data(), sizeof(Header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.formatVersion != FORMAT_VERSION ||
+        header.datasetVersion != datasetVersion) {
+        return;
+    }
+
+    m_open = mapColumns(header);
+    if (!m_open) {
+        std::cerr << "Ignoring truncated replay cache " << path << std::endl;
+    }
+}
+
+bool ReplayCache::mapColumns(const Header& header) {
+    const std::string_view file = m_file->view();
+    size_t offset = alignUp(sizeof(Header), COLUMN_ALIGNMENT);
+    auto& c = m_columns;
+
+    const bool mapped =
+        takeColumn(file, offset, header.gameCount, COLUMN_ALIGNMENT, c.gameIds) &&
+        takeColumn(file, offset, header.gameCount, COLUMN_ALIGNMENT, c.gameDays) &&
+        takeColumn(file, offset, header.gameCount, COLUMN_ALIGNMENT, c.homeClubIds) &&
+        takeColumn(file, offset, header.gameCount, COLUMN_ALIGNMENT, c.awayClubIds) &&
+        takeColumn(file, offset, header.gameCount, COLUMN_ALIGNMENT, c.homeGoals) &&
+        takeColumn(file, offset, header.gameCount, COLUMN_ALIGNMENT, c.awayGoals) &&
+        takeColumn(file, offset, header.gameCount + 1, COLUMN_ALIGNMENT, c.appearanceOffsets) &&
+        takeColumn(file, offset, header.appearanceCount, COLUMN_ALIGNMENT, c.playerIds) &&
+        takeColumn(file, offset, header.appearanceCount, COLUMN_ALIGNMENT, c.clubIds) &&
+        takeColumn(file, offset, header.appearanceCount, COLUMN_ALIGNMENT, c.goals) &&
+        takeColumn(file, offset, header.appearanceCount, COLUMN_ALIGNMENT, c.assists) &&
+        takeColumn(file, offset, header.appearanceCount, COLUMN_ALIGNMENT, c.minutesPlayed) &&
+        takeColumn(file, offset, header.clubCount, COLUMN_ALIGNMENT, c.nameClubIds) &&
+        takeColumn(file, offset, header.clubCount + 1, COLUMN_ALIGNMENT, c.nameOffsets);
+
+    if (!mapped || offset + header.nameBytes > file.size() ||
+        c.appearanceOffsets.back() != header.appearanceCount ||
+        c.nameOffsets.back() != header.nameBytes) {
+        return false;
+    }
+
+    c.nameData = file.substr(offset, header.nameBytes);
+    return true;
+}
+
+bool ReplayCache::write(sqlite3* db, const fs::path& path, int64_t datasetVersion) {
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<int32_t> gameIds, gameDays, homeClubIds, awayClubIds;
+    std::vector<uint8_t> homeGoals, awayGoals;
+    std::unordered_map<int32_t, uint32_t> gameIndex;
+    sqlite3_stmt* stmt = nullptr;
+
+    const char* gamesQuery = R"(
+        SELECT game_id, day, home_club_id, away_club_id, home_goals, away_goals
+        FROM games_compact
+        ORDER BY day, game_id
+    )";
+
+    if (sqlite3_prepare_v2(db, gamesQuery, -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Failed to read games for replay cache: " << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        gameIndex.emplace(sqlite3_column_int(stmt, 0), static_cast<uint32_t>(gameIds.size()));
+        gameIds.push_back(sqlite3_column_int(stmt, 0));
+        gameDays.push_back(sqlite3_column_int(stmt, 1));
+        homeClubIds.push_back(sqlite3_column_int(stmt, 2));
+        awayClubIds.push_back(sqlite3_column_int(stmt, 3));
+        homeGoals.push_back(narrow(sqlite3_column_int(stmt, 4)));
+        awayGoals.push_back(narrow(sqlite3_column_int(stmt, 5)));
+    }
+    sqlite3_finalize(stmt);
+
+    struct Appearance {
+        uint32_t game;
+        int32_t playerId;
+        int32_t clubId;
+        uint8_t goals;
+        uint8_t assists;
+        uint8_t minutesPlayed;
+    };
+
+    std::vector<Appearance> appearances;
+    std::vector<uint32_t> appearanceOffsets(gameIds.size() + 1, 0);
+
+    const char* appearancesQuery =
+        "SELECT game_id, player_id, club_id, goals, assists, minutes_played FROM appearances_compact";
+
+    if (sqlite3_prepare_v2(db, appearancesQuery, -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Failed to read appearances for replay cache: " << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const auto game = gameIndex.find(sqlite3_column_int(stmt, 0));
+        if (game == gameIndex.end()) {
+            continue;
+        }
+
+        appearances.push_back({
+            game->second,
+            sqlite3_column_int(stmt, 1),
+            sqlite3_column_int(stmt, 2),
+            narrow(sqlite3_column_int(stmt, 3)),
+            narrow(sqlite3_column_int(stmt, 4)),
+            narrow(sqlite3_column_int(stmt, 5))
+        });
+        appearanceOffsets[game->second + 1]++;
+    }
+    sqlite3_finalize(stmt);
+
+    for (size_t i = 1; i < appearanceOffsets.size(); i++) {
+        appearanceOffsets[i] += appearanceOffsets[i - 1];
+    }
+
+    std::vector<int32_t> playerIds(appearances.size()), clubIds(appearances.size());
+    std::vector<uint8_t> goals(appearances.size()), assists(appearances.size()), minutesPlayed(appearances.size());
+    std::vector<uint32_t> nextSlot(appearanceOffsets.begin(), appearanceOffsets.end() - 1);
+
+    for (const auto& appearance : appearances) {
+        const uint32_t slot = nextSlot[appearance.game]++;
+        playerIds[slot] = appearance.playerId;
+        clubIds[slot] = appearance.clubId;
+        goals[slot] = appearance.goals;
+        assists[slot] = appearance.assists;
+        minutesPlayed[slot] = appearance.minutesPlayed;
+    }
+
+    std::vector<int32_t> nameClubIds;
+    std::vector<uint32_t> nameOffsets{0};
+    std::string nameData;
+
+    if (sqlite3_prepare_v2(db, "SELECT club_id, name FROM club_names ORDER BY club_id", -1, &stmt, nullptr) != SQLITE_OK) {
+        std::cerr << "Failed to read club names for replay cache: " << sqlite3_errmsg(db) << std::endl;
+        return false;
+    }
+
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        const auto* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+        nameClubIds.push_back(sqlite3_column_int(stmt, 0));
+        nameData += name ? name : "";
+        nameOffsets.push_back(static_cast<uint32_t>(nameData.size()));
+    }
+    sqlite3_finalize(stmt);
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.datasetVersion = datasetVersion;
+    header.gameCount = static_cast<uint32_t>(gameIds.size());
+    header.appearanceCount = static_cast<uint32_t>(playerIds.size());
+    header.clubCount = static_cast<uint32_t>(nameClubIds.size());
+    header.nameBytes = static_cast<uint32_t>(nameData.size());
+
+    std::string out(reinterpret_cast<const char*>(&header), sizeof(Header));
+    out.resize(alignUp(out.size(), COLUMN_ALIGNMENT), '\0');
+
+    appendColumn(out, gameIds, COLUMN_ALIGNMENT);
+    appendColumn(out, gameDays, COLUMN_ALIGNMENT);
+    appendColumn(out, homeClubIds, COLUMN_ALIGNMENT);
+    appendColumn(out, awayClubIds, COLUMN_ALIGNMENT);
+    appendColumn(out, homeGoals, COLUMN_ALIGNMENT);
+    appendColumn(out, awayGoals, COLUMN_ALIGNMENT);
+    appendColumn(out, appearanceOffsets, COLUMN_ALIGNMENT);
+    appendColumn(out, playerIds, COLUMN_ALIGNMENT);
+    appendColumn(out, clubIds, COLUMN_ALIGNMENT);
+    appendColumn(out, goals, COLUMN_ALIGNMENT);
+    appendColumn(out, assists, COLUMN_ALIGNMENT);
+    appendColumn(out, minutesPlayed, COLUMN_ALIGNMENT);
+    appendColumn(out, nameClubIds, COLUMN_ALIGNMENT);
+    appendColumn(out, nameOffsets, COLUMN_ALIGNMENT);
+    out += nameData;
+
+    const fs::path tempPath = path.string() + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+            std::cerr << "Failed to write replay cache " << tempPath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        std::cerr << "Failed to replace replay cache " << path << ": " << ec.message() << std::endl;
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+    std::cout << "Wrote replay cache with " << header.gameCount << " games and " << header.appearanceCount
+              << " appearances in " << elapsed.count() << " ms" << std::endl;
+    return true;
+}
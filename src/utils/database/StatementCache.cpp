@@ -0,0 +1,96 @@
+#include "utils/database/StatementCache.h"
+#include <utility>
+
+StatementLease::~StatementLease() {
+    release();
+}
+
+StatementLease::StatementLease(StatementLease&& other) noexcept
+    : m_cache(std::exchange(other.m_cache, nullptr))
+    , m_slot(std::exchange(other.m_slot, nullptr))
+    , m_stmt(std::exchange(other.m_stmt, nullptr)) {
+}
+
+StatementLease& StatementLease::operator=(StatementLease&& other) noexcept {
+    if (this != &other) {
+        release();
+        m_cache = std::exchange(other.m_cache, nullptr);
+        m_slot = std::exchange(other.m_slot, nullptr);
+        m_stmt = std::exchange(other.m_stmt, nullptr);
+    }
+    return *this;
+}
+
+void StatementLease::release() noexcept {
+    if (m_stmt) {
+        m_cache->release(*m_slot, m_stmt);
+        m_stmt = nullptr;
+    }
+}
+
+StatementCache::StatementCache(sqlite3* db)
+    : m_db(db) {
+}
+
+StatementCache::~StatementCache() {
+    clear();
+}
+
+StatementLease StatementCache::acquire(std::string_view sql) {
+    std::vector<sqlite3_stmt*>* slot = nullptr;
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_idle.find(sql);
+        if (it == m_idle.end()) {
+            it = m_idle.emplace(std::string(sql), std::vector<sqlite3_stmt*>{}).first;
+        }
+        slot = &it->second;
+
+        if (!slot->empty()) {
+            sqlite3_stmt* stmt = slot->back();
+            slot->pop_back();
+            m_idleCount--;
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return {this, slot, stmt};
+        }
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v3(m_db, sql.data(), static_cast<int>(sql.size()), SQLITE_PREPARE_PERSISTENT, &stmt, nullptr) != SQLITE_OK) {
+        sqlite3_finalize(stmt);
+        return {};
+    }
+
+    return {this, slot, stmt};
+}
+
+void StatementCache::release(std::vector<sqlite3_stmt*>& slot, sqlite3_stmt* stmt) noexcept {
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+
+    std::lock_guard lock(m_mutex);
+    if (m_idleCount >= MAX_IDLE_STATEMENTS) {
+        sqlite3_finalize(stmt);
+        return;
+    }
+
+    slot.push_back(stmt);
+    m_idleCount++;
+}
+
+StatementCacheStats StatementCache::stats() const {
+    std::lock_guard lock(m_mutex);
+    return {m_hits.load(std::memory_order_relaxed), m_misses.load(std::memory_order_relaxed), m_idleCount};
+}
+
+void StatementCache::clear() {
+    std::lock_guard lock(m_mutex);
+    for (auto& [sql, statements] : m_idle) {
+        for (sqlite3_stmt* stmt : statements) {
+            sqlite3_finalize(stmt);
+        }
+        statements.clear();
+    }
+    m_idleCount = 0;
+}
@@ -0,0 +1,67 @@
+#include "utils/database/TableRegistry.h"
+#include "utils/database/repositories/AppearanceRepository.h"
+#include "utils/database/repositories/ClubRepository.h"
+#include "utils/database/repositories/GameRepository.h"
+#include "utils/database/repositories/PlayerRepository.h"
+#include "utils/database/repositories/TeamRepository.h"
+#include <algorithm>
+
+namespace {
+
+    const std::vector<std::string> DATASET_TABLES {
+        "appearances", "club_games", "clubs", "competitions",
+        "game_events", "game_lineups", "games", "player_valuations",
+        "players", "transfers"
+    };
+
+    template<size_t... Sizes>
+    std::vector<std::string> collectRequiredTables(const std::array<std::string_view, Sizes>&... declarations) {
+        std::vector<std::string> tables;
+
+        const auto collect = [&tables](const auto& declaration) {
+            for (const auto table : declaration) {
+                if (std::ranges::find(tables, table) == tables.end()) {
+                    tables.emplace_back(table);
+                }
+            }
+        };
+        (collect(declarations), ...);
+
+        std::ranges::sort(tables);
+        return tables;
+    }
+
+}
+
+std::span<const std::string> TableRegistry::datasetTables() {
+    return DATASET_TABLES;
+}
+
+const std::vector<std::string>& TableRegistry::requiredTables() {
+    static const auto tables = collectRequiredTables(
+        PlayerRepository::REQUIRED_TABLES,
+        ClubRepository::REQUIRED_TABLES,
+        GameRepository::REQUIRED_TABLES,
+        AppearanceRepository::REQUIRED_TABLES,
+        TeamRepository::REQUIRED_TABLES);
+    return tables;
+}
+
+const std::vector<std::string>& TableRegistry::deferredTables() {
+    static const auto tables = [] {
+        std::vector<std::string> deferred;
+        std::ranges::copy_if(DATASET_TABLES, std::back_inserter(deferred), [](const std::string& table) {
+            return !isRequired(table);
+        });
+        return deferred;
+    }();
+    return tables;
+}
+
+bool TableRegistry::isRequired(std::string_view tableName) {
+    return std::ranges::find(requiredTables(), tableName) != requiredTables().end();
+}
+
+bool TableRegistry::isDeferred(std::string_view tableName) {
+    return std::ranges::find(deferredTables(), tableName) != deferredTables().end();
+}
@@ -1,38 +1,50 @@
 #include "utils/database/repositories/ClubRepository.h"
+#include "utils/database/NameSearch.h"
 #include "utils/Season.h"
 #include <iostream>
 #include <tuple>
 #include <algorithm>
 
 ClubRepository::ClubRepository(Database& database) 
-    : m_db(database.getConnection()) {
+    : ClubRepository(database.connections()) {
+}
+
+ClubRepository::ClubRepository(ConnectionPool& connections)
+    : m_connections(&connections) {
 }
 
 std::vector<Club> ClubRepository::fetchClubs(std::optional<int> clubId) const {
+    return scanClubs(clubId).collect();
+}
+
+RowCursor<Club> ClubRepository::scanClubs(std::optional<int> clubId) const {
     const int currentSeasonYear = getCurrentSeasonYear();
     
     if (clubId.has_value()) {
-        return executeQuery("SELECT club_id, name FROM clubs WHERE last_season = ? AND club_id = ?", 
-                           currentSeasonYear, *clubId);
+        return scanQuery(std::string(BASE_QUERY) + " WHERE c.last_season = ? AND c.club_id = ?", 
+                         currentSeasonYear, *clubId);
     } else {
-        return executeQuery("SELECT club_id, name FROM clubs WHERE last_season = ?", 
-                           currentSeasonYear);
+        return scanQuery(std::string(BASE_QUERY) + " WHERE c.last_season = ?", 
+                         currentSeasonYear);
     }
 }
 
 std::optional<Club> ClubRepository::fetchClubById(int clubId) const {
-    auto clubs = fetchClubs(clubId);
-    return clubs.empty() ? std::nullopt : std::optional{clubs.front()};
+    return scanClubs(clubId).first();
+}
+
+std::vector<int> ClubRepository::searchClubIds(std::string_view text) const {
+    return NameSearch::search(m_connections->reader(), "club_name_search", text);
 }
 
 template<std::integral... Params>
-std::vector<Club> ClubRepository::executeQuery(std::string_view query, Params... params) const {
-    std::vector<Club> clubs;
-    sqlite3_stmt* stmt = nullptr;
+RowCursor<Club> ClubRepository::scanQuery(std::string_view query, Params... params) const {
+    StatementCache& statements = m_connections->reader();
+    auto stmt = statements.acquire(query);
     
-    if (sqlite3_prepare_v2(m_db, query.data(), static_cast<int>(query.size()), &stmt, nullptr) != SQLITE_OK) {
-        std::cerr << "SQL prepare error: " << sqlite3_errmsg(m_db) << std::endl;
-        return clubs;
+    if (!stmt) {
+        std::cerr << "SQL prepare error: " << sqlite3_errmsg(statements.connection()) << std::endl;
+        return {};
     }
     
     if constexpr (sizeof...(params) > 0) {
@@ -40,16 +52,7 @@ std::vector<Club> ClubRepository::executeQuery(std::string_view query, Params...
         (sqlite3_bind_int(stmt, paramIndex++, params), ...);
     }
     
-    try {
-        while (sqlite3_step(stmt) == SQLITE_ROW) {
-            clubs.push_back(extractClubFromStatement(stmt));
-        }
-    } catch (const std::exception& e) {
-        std::cerr << "Error extracting club data: " << e.what() << std::endl;
-    }
-    
-    sqlite3_finalize(stmt);
-    return clubs;
+    return {std::move(stmt), &ClubRepository::extractClubFromStatement};
 }
 
 Club ClubRepository::extractClubFromStatement(sqlite3_stmt* stmt) {
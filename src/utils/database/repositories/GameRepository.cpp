@@ -2,38 +2,40 @@
 #include <iostream>
 
 GameRepository::GameRepository(Database& database)
-    : m_db(database.getConnection()) {
+    : m_connections(&database.connections()) {
 }
 
 std::vector<Game> GameRepository::fetchGames() const {
-    return executeQuery(BASE_QUERY);
+    return scanGames().collect();
+}
+
+RowCursor<Game> GameRepository::scanGames() const {
+    return scanQuery(BASE_QUERY);
 }
 
 std::optional<Game> GameRepository::fetchGameById(int gameId) const {
-    std::string query = std::string(BASE_QUERY) + " WHERE cg.game_id = ?";
-    auto games = executeQuery(query, gameId);
-    
-    return games.empty() ? std::nullopt : std::optional{games.front()};
+    std::string query = std::string(BASE_QUERY) + " WHERE g.game_id = ?";
+    return scanQuery(query, gameId).first();
 }
 
 std::vector<Game> GameRepository::fetchGamesForClub(int clubId) const {
-    std::string query = std::string(BASE_QUERY) + " WHERE cg.club_id = ? OR cg.opponent_id = ?";
-    return executeQuery(query, clubId, clubId);
+    std::string query = std::string(BASE_QUERY) + " WHERE g.home_club_id = ? OR g.away_club_id = ?";
+    return scanQuery(query, clubId, clubId).collect();
 }
 
 std::vector<Game> GameRepository::fetchRecentGames(int limit) const {
-    std::string query = std::string(BASE_QUERY) + " ORDER BY g.date DESC LIMIT ?";
-    return executeQuery(query, limit);
+    std::string query = std::string(BASE_QUERY) + " ORDER BY g.day DESC LIMIT ?";
+    return scanQuery(query, limit).collect();
 }
 
 template<typename... Args>
-std::vector<Game> GameRepository::executeQuery(const std::string& query, Args... args) const {
-    sqlite3_stmt* stmt = nullptr;
-    std::vector<Game> games;
+RowCursor<Game> GameRepository::scanQuery(const std::string& query, Args... args) const {
+    StatementCache& statements = m_connections->reader();
+    auto stmt = statements.acquire(query);
     
-    if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, 0) != SQLITE_OK) {
-        std::cerr << "SQL error: " << sqlite3_errmsg(m_db) << std::endl;
-        return games;
+    if (!stmt) {
+        std::cerr << "SQL error: " << sqlite3_errmsg(statements.connection()) << std::endl;
+        return {};
     }
     
     if constexpr (sizeof...(args) > 0) {
@@ -41,15 +43,10 @@ std::vector<Game> GameRepository::executeQuery(const std::string& query, Args...
         (sqlite3_bind_int(stmt, paramIndex++, args), ...);
     }
     
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        games.push_back(extractGameFromStatement(stmt));
-    }
-    
-    sqlite3_finalize(stmt);
-    return games;
+    return {std::move(stmt), &GameRepository::extractGameFromStatement};
 }
 
-Game GameRepository::extractGameFromStatement(sqlite3_stmt* stmt) const {
+Game GameRepository::extractGameFromStatement(sqlite3_stmt* stmt) {
     Game game;
     game.gameId = sqlite3_column_int(stmt, 0);
     game.homeClubId = sqlite3_column_int(stmt, 1);
@@ -59,11 +56,10 @@ Game GameRepository::extractGameFromStatement(sqlite3_stmt* stmt) const {
     
     const unsigned char* homeClubName = sqlite3_column_text(stmt, 5);
     const unsigned char* awayClubName = sqlite3_column_text(stmt, 6);
-    const unsigned char* dateText = sqlite3_column_text(stmt, 7);
     
     game.homeClubName = homeClubName ? reinterpret_cast<const char*>(homeClubName) : "Unknown";
     game.awayClubName = awayClubName ? reinterpret_cast<const char*>(awayClubName) : "Unknown";
-    game.date = dateText ? reinterpret_cast<const char*>(dateText) : "";
+    game.day = sqlite3_column_int(stmt, 7);
     
     return game;
 }
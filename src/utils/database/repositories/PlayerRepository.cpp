@@ -1,5 +1,6 @@
 #include "utils/database/repositories/PlayerRepository.h"
 #include "utils/database/PlayerMapper.h"
+#include "utils/database/NameSearch.h"
 #include "utils/Season.h"
 #include <iostream>
 #include <array>
@@ -8,58 +9,51 @@
 #include <format>
 
 PlayerRepository::PlayerRepository(Database& database)
-    : m_db(database.getConnection()) {
+    : PlayerRepository(database.connections()) {
 }
 
-PlayerRepository::PlayerRepository(sqlite3* db)
-    : m_db(db) {
+PlayerRepository::PlayerRepository(ConnectionPool& connections)
+    : m_connections(&connections) {
 }
 
 std::vector<Player> PlayerRepository::fetchPlayers(std::optional<int> clubId,
                                                   std::optional<int> playerId,
                                                   std::optional<int> teamId) const {
+    return scanPlayers(clubId, playerId, teamId).collect();
+}
+
+RowCursor<Player> PlayerRepository::scanPlayers(std::optional<int> clubId,
+                                                std::optional<int> playerId,
+                                                std::optional<int> teamId) const {
     int currentSeasonYear = getCurrentSeasonYear();
 
-    std::string query = R"(
-        SELECT 
-            player_id, 
-            current_club_id, 
-            name, 
-            current_club_name, 
-            sub_position, 
-            position, 
-            contract_expiration_date, 
-            market_value_in_eur, 
-            highest_market_value_in_eur,
-            image_url
-        FROM players
-        WHERE last_season = ?
-    )";
+    std::string query = std::string("SELECT") + PLAYER_COLUMNS +
+                        "\n        FROM players_compact p" + PLAYER_JOINS +
+                        "\n        WHERE p.last_season = ?";
 
     std::vector<std::pair<int, int>> params = {{1, currentSeasonYear}};
     int paramIndex = 2;
 
     if (clubId && *clubId != -1) {
-        query += " AND current_club_id = ?";
+        query += " AND p.club_id = ?";
         params.emplace_back(paramIndex++, *clubId);
     }
 
     if (playerId && *playerId != -1) {
-        query += " AND player_id = ?";
+        query += " AND p.player_id = ?";
         params.emplace_back(paramIndex++, *playerId);
     }
 
     if (teamId && *teamId != -1) {
-        query += " AND player_id IN (SELECT player_id FROM team_players WHERE team_id = ?)";
+        query += " AND p.player_id IN (SELECT player_id FROM team_players WHERE team_id = ?)";
         params.emplace_back(paramIndex, *teamId);
     }
 
-    return executeQuery(query, params);
+    return scanQuery(query, params);
 }
 
 std::optional<Player> PlayerRepository::fetchPlayerById(int playerId) const {
-    auto players = fetchPlayers(std::nullopt, playerId);
-    return players.empty() ? std::nullopt : std::optional{players.front()};
+    return scanPlayers(std::nullopt, playerId).first();
 }
 
 std::vector<Player> PlayerRepository::fetchPlayersByClub(int clubId) const {
@@ -70,24 +64,50 @@ std::vector<Player> PlayerRepository::fetchPlayersByTeam(int teamId) const {
     return fetchPlayers(std::nullopt, std::nullopt, teamId);
 }
 
-std::vector<Player> PlayerRepository::executeQuery(std::string_view query, 
-                                                  std::span<const std::pair<int, int>> params) const {
-    std::vector<Player> players;
-    sqlite3_stmt* stmt = nullptr;
+std::vector<int> PlayerRepository::searchPlayerIds(std::string_view text) const {
+    return NameSearch::search(m_connections->reader(), "player_name_search", text);
+}
 
-    if (sqlite3_prepare_v2(m_db, query.data(), static_cast<int>(query.size()), &stmt, nullptr) != SQLITE_OK) {
-        std::cerr << "SQL error: " << sqlite3_errmsg(m_db) << std::endl;
-        return players;
-    }
+std::unordered_map<int, std::vector<Player>> PlayerRepository::fetchPlayersByAllTeams() const {
+    std::unordered_map<int, std::vector<Player>> playersByTeam;
 
-    for (const auto& [index, value] : params) {
-        sqlite3_bind_int(stmt, index, value);
+    // team_players drives the join, so this costs one primary key lookup per saved player.
+    const std::string query = std::string("SELECT") + PLAYER_COLUMNS + ",\n            tp.team_id" +
+                              "\n        FROM team_players tp" +
+                              "\n        JOIN players_compact p ON p.player_id = tp.player_id" + PLAYER_JOINS +
+                              "\n        WHERE p.last_season = ?";
+
+    StatementCache& statements = m_connections->reader();
+    auto stmt = statements.acquire(query);
+
+    if (!stmt) {
+        std::cerr << "SQL error: " << sqlite3_errmsg(statements.connection()) << std::endl;
+        return playersByTeam;
     }
 
+    sqlite3_bind_int(stmt, 1, getCurrentSeasonYear());
+
+    constexpr int TEAM_ID_COLUMN = 10;
     while (sqlite3_step(stmt) == SQLITE_ROW) {
-        players.push_back(PlayerMapper::mapPlayerFromStatement(stmt));
+        playersByTeam[sqlite3_column_int(stmt, TEAM_ID_COLUMN)].push_back(PlayerMapper::mapPlayerFromStatement(stmt));
+    }
+
+    return playersByTeam;
+}
+
+RowCursor<Player> PlayerRepository::scanQuery(std::string_view query, 
+                                              std::span<const std::pair<int, int>> params) const {
+    StatementCache& statements = m_connections->reader();
+    auto stmt = statements.acquire(query);
+
+    if (!stmt) {
+        std::cerr << "SQL error: " << sqlite3_errmsg(statements.connection()) << std::endl;
+        return {};
+    }
+
+    for (const auto& [index, value] : params) {
+        sqlite3_bind_int(stmt, index, value);
     }
 
-    sqlite3_finalize(stmt);
-    return players;
+    return {std::move(stmt), &PlayerMapper::mapPlayerFromStatement};
 }
@@ -8,43 +8,42 @@
 
 TeamRepository::TeamRepository(Database& database) {
     m_db = database.getConnection();
+    m_statements = &database.connections().writer();
 }
 
 std::vector<std::string> TeamRepository::getAvailableSubPositions() const {
     std::vector<std::string> subPositions;
-    sqlite3_stmt* stmt = nullptr;
     
-    const std::string query = "SELECT DISTINCT sub_position FROM players WHERE sub_position IS NOT NULL;";
+    const std::string query = R"(
+        SELECT name FROM position_codes pc
+        WHERE EXISTS (SELECT 1 FROM players_compact p WHERE p.sub_position_code = pc.position_code);
+    )";
     
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         while (sqlite3_step(stmt) == SQLITE_ROW) {
             subPositions.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
         }
     }
     
-    sqlite3_finalize(stmt);
     return subPositions;
 }
 
 void TeamRepository::createTeam(const Team& team) {
     const std::string query = "INSERT INTO teams (team_id, team_name) VALUES (?, ?);";
     
-    sqlite3_stmt* stmt = nullptr;
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, team.teamId);
         sqlite3_bind_text(stmt, 2, team.teamName.c_str(), -1, SQLITE_TRANSIENT);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
     }
 }
 
 std::vector<Team> TeamRepository::getAllTeams() const {
     std::vector<Team> teams;
-    sqlite3_stmt* stmt = nullptr;
     
     const std::string query = "SELECT team_id, team_name FROM teams;";
     
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         while (sqlite3_step(stmt) == SQLITE_ROW) {
             int teamId = sqlite3_column_int(stmt, 0);
             std::string teamName = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
@@ -52,62 +51,52 @@ std::vector<Team> TeamRepository::getAllTeams() const {
         }
     }
     
-    sqlite3_finalize(stmt);
     return teams;
 }
 
 void TeamRepository::addPlayerToTeam(int teamId, int playerId) {
     const std::string query = "INSERT INTO team_players (team_id, player_id) VALUES (?, ?);";
     
-    sqlite3_stmt* stmt = nullptr;
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, teamId);
         sqlite3_bind_int(stmt, 2, playerId);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
     }
 }
 
 void TeamRepository::removePlayerFromTeam(int teamId, int playerId) {
     const std::string query = "DELETE FROM team_players WHERE team_id = ? AND player_id = ?;";
     
-    sqlite3_stmt* stmt = nullptr;
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, teamId);
         sqlite3_bind_int(stmt, 2, playerId);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
     }
 }
 
 void TeamRepository::removeAllPlayersFromTeam(int teamId) {
     const std::string query = "DELETE FROM team_players WHERE team_id = ?;";
     
-    sqlite3_stmt* stmt = nullptr;
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, teamId);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
     }
 }
 
 void TeamRepository::deleteTeam(int teamId) {
     const std::string query = "DELETE FROM teams WHERE team_id = ?;";
     
-    sqlite3_stmt* stmt = nullptr;
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, teamId);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
     }
 }
 
 bool TeamRepository::updateTeamName(int teamId, std::string_view newName) {
     const std::string query = "UPDATE teams SET team_name = ? WHERE team_id = ?;";
-    sqlite3_stmt* stmt = nullptr;
     bool success = false;
     
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_text(stmt, 1, newName.data(), static_cast<int>(newName.size()), SQLITE_TRANSIENT);
         sqlite3_bind_int(stmt, 2, teamId);
         
@@ -116,7 +105,6 @@ bool TeamRepository::updateTeamName(int teamId, std::string_view newName) {
         }
     }
     
-    sqlite3_finalize(stmt);
     return success;
 }
 
@@ -137,11 +125,10 @@ PositionType TeamRepository::stringToPositionType(std::string_view positionType)
 
 std::vector<Formation> TeamRepository::getAllFormations() const {
     std::vector<Formation> formations;
-    sqlite3_stmt* stmt = nullptr;
     
     const std::string query = "SELECT formation_id, formation_name, description FROM team_formations;";
     
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         while (sqlite3_step(stmt) == SQLITE_ROW) {
             Formation formation;
             formation.id = sqlite3_column_int(stmt, 0);
@@ -155,20 +142,17 @@ std::vector<Formation> TeamRepository::getAllFormations() const {
         }
     }
     
-    sqlite3_finalize(stmt);
     return formations;
 }
 
 bool TeamRepository::deactivateTeamLineups(int teamId) const {
     const std::string query = "UPDATE team_lineups SET is_active = 0 WHERE team_id = ?;";
     
-    sqlite3_stmt* stmt = nullptr;
     bool success = false;
     
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, teamId);
         success = (sqlite3_step(stmt) == SQLITE_DONE);
-        sqlite3_finalize(stmt);
     }
     
     return success;
@@ -181,10 +165,9 @@ int TeamRepository::createLineup(int teamId, int formationId, std::string_view l
     }
     
     const std::string query = "INSERT INTO team_lineups (team_id, formation_id, is_active, lineup_name) VALUES (?, ?, 1, ?);";
-    sqlite3_stmt* stmt = nullptr;
     int lineupId = -1;
     
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, teamId);
         sqlite3_bind_int(stmt, 2, formationId);
         
@@ -199,7 +182,6 @@ int TeamRepository::createLineup(int teamId, int formationId, std::string_view l
         }
     }
     
-    sqlite3_finalize(stmt);
     return lineupId;
 }
 
@@ -220,9 +202,7 @@ Lineup TeamRepository::getActiveLineup(int teamId) const {
         WHERE l.team_id = ? AND l.is_active = 1;
     )";
     
-    sqlite3_stmt* stmt = nullptr;
-    
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, teamId);
         
         if (sqlite3_step(stmt) == SQLITE_ROW) {
@@ -238,8 +218,6 @@ Lineup TeamRepository::getActiveLineup(int teamId) const {
         }
     }
     
-    sqlite3_finalize(stmt);
-    
     if (lineup.lineupId > 0) {
         bool success = fillLineupPlayerPositions(lineup);
         if (!success) {
@@ -261,9 +239,8 @@ bool TeamRepository::fillLineupPlayerPositions(Lineup& lineup) const {
         WHERE lineup_id = ?;
     )";
     
-    sqlite3_stmt* stmt = nullptr;
-    
-    if (!prepareStatement(query, &stmt)) {
+    auto stmt = prepareStatement(query);
+    if (!stmt) {
         return false;
     }
     
@@ -285,7 +262,6 @@ bool TeamRepository::fillLineupPlayerPositions(Lineup& lineup) const {
         lineup.playerPositions.push_back(playerPos);
     }
     
-    sqlite3_finalize(stmt);
     return true;
 }
 
@@ -296,14 +272,12 @@ bool TeamRepository::setActiveLineup(int teamId, int lineupId) {
     
     const std::string query = "UPDATE team_lineups SET is_active = 1 WHERE lineup_id = ? AND team_id = ?;";
     
-    sqlite3_stmt* stmt = nullptr;
     bool success = false;
     
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, lineupId);
         sqlite3_bind_int(stmt, 2, teamId);
         success = (sqlite3_step(stmt) == SQLITE_DONE);
-        sqlite3_finalize(stmt);
     }
     
     return success;
@@ -321,9 +295,8 @@ bool TeamRepository::updatePlayerPosition(int lineupId, int playerId, PositionTy
             position_order = excluded.position_order;
     )";
     
-    sqlite3_stmt* stmt = nullptr;
-    
-    if (!prepareStatement(query, &stmt)) {
+    auto stmt = prepareStatement(query);
+    if (!stmt) {
         return false;
     }
     
@@ -342,7 +315,6 @@ bool TeamRepository::updatePlayerPosition(int lineupId, int playerId, PositionTy
     sqlite3_bind_int(stmt, 5, order);
     
     bool success = (sqlite3_step(stmt) == SQLITE_DONE);
-    sqlite3_finalize(stmt);
     
     return success;
 }
@@ -361,9 +333,7 @@ bool TeamRepository::saveLineup(const Lineup& lineup) {
             lineup_name = excluded.lineup_name;
     )";
     
-    sqlite3_stmt* stmt = nullptr;
-    
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, lineup.lineupId);
         sqlite3_bind_int(stmt, 2, lineup.teamId);
         sqlite3_bind_int(stmt, 3, lineup.formationId);
@@ -380,17 +350,13 @@ bool TeamRepository::saveLineup(const Lineup& lineup) {
         success = false;
     }
     
-    sqlite3_finalize(stmt);
-    
     if (success && lineup.isActive) {
         const std::string deactivateQuery = "UPDATE team_lineups SET is_active = 0 WHERE team_id = ? AND lineup_id != ?;";
         
-        sqlite3_stmt* deactivateStmt = nullptr;
-        if (prepareStatement(deactivateQuery, &deactivateStmt)) {
+        if (auto deactivateStmt = prepareStatement(deactivateQuery)) {
             sqlite3_bind_int(deactivateStmt, 1, lineup.teamId);
             sqlite3_bind_int(deactivateStmt, 2, lineup.lineupId);
             success = (sqlite3_step(deactivateStmt) == SQLITE_DONE);
-            sqlite3_finalize(deactivateStmt);
         } else {
             success = false;
         }
@@ -399,11 +365,9 @@ bool TeamRepository::saveLineup(const Lineup& lineup) {
     if (success) {
         const std::string clearQuery = "DELETE FROM lineup_players WHERE lineup_id = ?;";
         
-        sqlite3_stmt* clearStmt = nullptr;
-        if (prepareStatement(clearQuery, &clearStmt)) {
+        if (auto clearStmt = prepareStatement(clearQuery)) {
             sqlite3_bind_int(clearStmt, 1, lineup.lineupId);
             success = (sqlite3_step(clearStmt) == SQLITE_DONE);
-            sqlite3_finalize(clearStmt);
         } else {
             success = false;
         }
@@ -423,10 +387,10 @@ bool TeamRepository::saveLineupPlayers(const Lineup& lineup) const {
         VALUES (?, ?, ?, ?, ?);
     )";
     
-    sqlite3_stmt* stmt = nullptr;
-    bool success = prepareStatement(query, &stmt);
+    auto stmt = prepareStatement(query);
+    bool success = true;
     
-    if (!success) {
+    if (!stmt) {
         return false;
     }
     
@@ -452,20 +416,17 @@ bool TeamRepository::saveLineupPlayers(const Lineup& lineup) const {
         }
     }
     
-    sqlite3_finalize(stmt);
     return success;
 }
 
 bool TeamRepository::deleteLineup(int lineupId) {
     const std::string query = "DELETE FROM team_lineups WHERE lineup_id = ?;";
     
-    sqlite3_stmt* stmt = nullptr;
     bool success = false;
     
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, lineupId);
         success = (sqlite3_step(stmt) == SQLITE_DONE);
-        sqlite3_finalize(stmt);
     }
     
     return success;
@@ -482,9 +443,7 @@ std::vector<Lineup> TeamRepository::getTeamLineups(int teamId) const {
         WHERE l.team_id = ?;
     )";
     
-    sqlite3_stmt* stmt = nullptr;
-    
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, teamId);
         
         while (sqlite3_step(stmt) == SQLITE_ROW) {
@@ -503,8 +462,6 @@ std::vector<Lineup> TeamRepository::getTeamLineups(int teamId) const {
         }
     }
     
-    sqlite3_finalize(stmt);
-    
     for (auto& lineup : lineups) {
         bool success = fillLineupPlayerPositions(lineup);
         if (!success) {
@@ -525,24 +482,22 @@ void TeamRepository::removePlayerFromAllLineups(int teamId, int playerId) {
         );
     )";
     
-    sqlite3_stmt* stmt = nullptr;
-    if (prepareStatement(query, &stmt)) {
+    if (auto stmt = prepareStatement(query)) {
         sqlite3_bind_int(stmt, 1, playerId);
         sqlite3_bind_int(stmt, 2, teamId);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
     }
 }
 
-bool TeamRepository::prepareStatement(std::string_view query, sqlite3_stmt** stmt) const {
-    return sqlite3_prepare_v2(m_db, query.data(), static_cast<int>(query.size()), stmt, nullptr) == SQLITE_OK;
+StatementLease TeamRepository::prepareStatement(std::string_view query) const {
+    return m_statements->acquire(query);
 }
 
 bool TeamRepository::executeStatement(std::string_view query, 
                                     std::span<const std::pair<int, int>> intBindings,
                                     std::span<const std::pair<int, std::string>> textBindings) const {
-    sqlite3_stmt* stmt = nullptr;
-    if (!prepareStatement(query, &stmt)) {
+    auto stmt = prepareStatement(query);
+    if (!stmt) {
         return false;
     }
 
@@ -559,7 +514,6 @@ bool TeamRepository::executeStatement(std::string_view query,
     }
     
     int result = sqlite3_step(stmt);
-    sqlite3_finalize(stmt);
     return result == SQLITE_DONE;
 }
 
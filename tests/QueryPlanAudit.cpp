@@ -0,0 +1,229 @@
+#include "utils/database/Database.h"
+#include "utils/database/QueryPlanAuditor.h"
+#include "utils/database/repositories/AppearanceRepository.h"
+#include "utils/database/repositories/ClubRepository.h"
+#include "utils/database/repositories/GameRepository.h"
+#include "utils/database/repositories/PlayerRepository.h"
+#include "utils/database/repositories/TeamRepository.h"
+#include <sqlite3.h>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Builds a small dataset and user database, runs every repository query against it
+// and fails when any of them scans a large dataset table. The schemas are read
+// from ../db like the application does, see add_test in CMakeLists.txt.
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    constexpr std::string_view DATASET_SCHEMA_PATH = "../db/data.sql";
+    constexpr std::string_view USER_SCHEMA_PATH = "../db/user.sql";
+
+    // Enough rows that the planner weighs indexes against scans as it does on the
+    // real dataset. The compact tables are built from these by Database::initialize.
+    constexpr const char* DATASET_ROWS = R"(
+        WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 4000)
+        INSERT INTO competitions (competition_id, name, type)
+        SELECT 'C' || i, 'Competition ' || i, 'domestic_league' FROM n WHERE i <= 4;
+
+        WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 4000)
+        INSERT INTO clubs (club_id, name, domestic_competition_id, last_season)
+        SELECT i, 'Club ' || i, 'C' || (i % 4 + 1), 2024 FROM n WHERE i <= 20;
+
+        WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 4000)
+        INSERT INTO players (player_id, name, last_season, current_club_id, current_club_name,
+                             sub_position, position, contract_expiration_date,
+                             market_value_in_eur, highest_market_value_in_eur)
+        SELECT i, 'Player ' || i, 2024, i % 20 + 1, 'Club ' || (i % 20 + 1),
+               CASE i % 4 WHEN 0 THEN 'Goalkeeper' WHEN 1 THEN 'Centre-Back'
+                          WHEN 2 THEN 'Central Midfield' ELSE 'Centre-Forward' END,
+               CASE i % 4 WHEN 0 THEN 'Goalkeeper' WHEN 1 THEN 'Defender'
+                          WHEN 2 THEN 'Midfield' ELSE 'Attack' END,
+               '2026-06-30', i * 10000, i * 20000
+        FROM n WHERE i <= 400;
+
+        WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 4000)
+        INSERT INTO games (game_id, competition_id, season, date, home_club_id, away_club_id,
+                           home_club_goals, away_club_goals)
+        SELECT i, 'C' || (i % 4 + 1), 2024, date('2024-01-01', '+' || (i / 4) || ' days'),
+               i % 20 + 1, (i + 7) % 20 + 1, i % 3, i % 2
+        FROM n WHERE i <= 300;
+
+        WITH RECURSIVE n(i) AS (SELECT 1 UNION ALL SELECT i + 1 FROM n WHERE i < 4000)
+        INSERT INTO appearances (appearance_id, game_id, player_id, player_club_id, date,
+                                 goals, assists, minutes_played)
+        SELECT 'A' || i, i % 300 + 1, i % 400 + 1, i % 20 + 1, '2024-01-01', i % 2, i % 3, 90
+        FROM n;
+    )";
+
+    constexpr const char* USER_ROWS = R"(
+        INSERT INTO metadata (key, value) VALUES ('last_updated', strftime('%s', 'now'));
+    )";
+
+    struct AuditedCall {
+        std::string_view name;
+        // The one large table the call reads in full by design, e.g. to replay every game.
+        std::string_view expectedScan;
+        std::function<void()> run;
+    };
+
+    std::string readFile(std::string_view path) {
+        std::ifstream file{std::string(path)};
+        std::stringstream ss;
+        ss << file.rdbuf();
+        return ss.str();
+    }
+
+    bool buildDatabase(const fs::path& path, std::string_view schemaPath, const char* rows) {
+        const std::string schema = readFile(schemaPath);
+        if (schema.empty()) {
+            std::cerr << "Failed to read " << schemaPath << ". Run from a directory next to db/." << std::endl;
+            return false;
+        }
+
+        sqlite3* db = nullptr;
+        if (sqlite3_open(path.string().c_str(), &db) != SQLITE_OK) {
+            std::cerr << "Failed to create " << path << ": " << sqlite3_errmsg(db) << std::endl;
+            sqlite3_close(db);
+            return false;
+        }
+
+        const std::string statements = "BEGIN;" + schema + rows + "COMMIT;";
+        char* errMsg = nullptr;
+        const bool built = sqlite3_exec(db, statements.c_str(), nullptr, nullptr, &errMsg) == SQLITE_OK;
+        if (!built) {
+            std::cerr << "Failed to fill " << path << ": " << errMsg << std::endl;
+            sqlite3_free(errMsg);
+        }
+
+        sqlite3_close(db);
+        return built;
+    }
+
+    std::vector<AuditedCall> repositoryCalls(Database& database) {
+        auto players = std::make_shared<PlayerRepository>(database);
+        auto clubs = std::make_shared<ClubRepository>(database);
+        auto games = std::make_shared<GameRepository>(database);
+        auto appearances = std::make_shared<AppearanceRepository>(database);
+        auto teams = std::make_shared<TeamRepository>(database);
+        auto lineupId = std::make_shared<int>(0);
+
+        constexpr int TEAM_ID = 1;
+        constexpr int PLAYER_ID = 42;
+        constexpr int CLUB_ID = 3;
+        constexpr int GAME_ID = 17;
+
+        return {
+            {"PlayerRepository::fetchPlayers", {}, [=] { (void)players->fetchPlayers(); }},
+            {"PlayerRepository::fetchPlayerById", {}, [=] { (void)players->fetchPlayerById(PLAYER_ID); }},
+            {"PlayerRepository::fetchPlayersByClub", {}, [=] { (void)players->fetchPlayersByClub(CLUB_ID); }},
+            {"PlayerRepository::searchPlayerIds", {}, [=] { (void)players->searchPlayerIds("Player 4"); }},
+            {"PlayerRepository::searchPlayerIds (short)", {}, [=] { (void)players->searchPlayerIds("4"); }},
+            {"ClubRepository::fetchClubs", {}, [=] { (void)clubs->fetchClubs(); }},
+            {"ClubRepository::fetchClubById", {}, [=] { (void)clubs->fetchClubById(CLUB_ID); }},
+            {"ClubRepository::searchClubIds", {}, [=] { (void)clubs->searchClubIds("Club 1"); }},
+            {"GameRepository::fetchGames", "games_compact", [=] { (void)games->fetchGames(); }},
+            {"GameRepository::fetchGameById", {}, [=] { (void)games->fetchGameById(GAME_ID); }},
+            {"GameRepository::fetchGamesForClub", {}, [=] { (void)games->fetchGamesForClub(CLUB_ID); }},
+            // Walks idx_games_compact_day newest first and stops at the limit.
+            {"GameRepository::fetchRecentGames", "games_compact", [=] { (void)games->fetchRecentGames(); }},
+            {"AppearanceRepository::fetchAppearances", "appearances_compact", [=] { (void)appearances->fetchAppearances(); }},
+            {"AppearanceRepository::fetchPlayerAppearances", {}, [=] { (void)appearances->fetchPlayerAppearances(PLAYER_ID); }},
+            {"AppearanceRepository::fetchGameAppearances", {}, [=] { (void)appearances->fetchGameAppearances(GAME_ID); }},
+            {"AppearanceRepository::fetchAppearance", {}, [=] { (void)appearances->fetchAppearance(PLAYER_ID, GAME_ID); }},
+            {"TeamRepository::getAvailableSubPositions", {}, [=] { (void)teams->getAvailableSubPositions(); }},
+            {"TeamRepository::createTeam", {}, [=] { teams->createTeam(Team(TEAM_ID, "Audit")); }},
+            {"TeamRepository::updateTeamName", {}, [=] { (void)teams->updateTeamName(TEAM_ID, "Audited"); }},
+            {"TeamRepository::getAllTeams", {}, [=] { (void)teams->getAllTeams(); }},
+            {"TeamRepository::addPlayerToTeam", {}, [=] { teams->addPlayerToTeam(TEAM_ID, PLAYER_ID); }},
+            {"PlayerRepository::fetchPlayersByTeam", {}, [=] { (void)players->fetchPlayersByTeam(TEAM_ID); }},
+            {"PlayerRepository::fetchPlayersByAllTeams", {}, [=] { (void)players->fetchPlayersByAllTeams(); }},
+            {"TeamRepository::getAllFormations", {}, [=] { (void)teams->getAllFormations(); }},
+            {"TeamRepository::createLineup", {}, [=] { *lineupId = teams->createLineup(TEAM_ID, 1, "Audit"); }},
+            {"TeamRepository::setActiveLineup", {}, [=] { (void)teams->setActiveLineup(TEAM_ID, *lineupId); }},
+            {"TeamRepository::updatePlayerPosition", {}, [=] {
+                (void)teams->updatePlayerPosition(*lineupId, PLAYER_ID, PositionType::STARTING, "GK", 1);
+            }},
+            {"TeamRepository::saveLineup", {}, [=] { (void)teams->saveLineup(teams->getActiveLineup(TEAM_ID)); }},
+            {"TeamRepository::getTeamLineups", {}, [=] { (void)teams->getTeamLineups(TEAM_ID); }},
+            {"TeamRepository::removePlayerFromAllLineups", {}, [=] { teams->removePlayerFromAllLineups(TEAM_ID, PLAYER_ID); }},
+            {"TeamRepository::removePlayerFromTeam", {}, [=] { teams->removePlayerFromTeam(TEAM_ID, PLAYER_ID); }},
+            {"TeamRepository::deleteLineup", {}, [=] { (void)teams->deleteLineup(*lineupId); }},
+            {"TeamRepository::removeAllPlayersFromTeam", {}, [=] { teams->removeAllPlayersFromTeam(TEAM_ID); }},
+            {"TeamRepository::deleteTeam", {}, [=] { teams->deleteTeam(TEAM_ID); }},
+        };
+    }
+
+}
+
+int main() {
+    const fs::path directory = fs::temp_directory_path() / "elometry-query-plan-audit";
+    std::error_code error;
+    fs::remove_all(directory, error);
+    fs::create_directories(directory);
+
+    if (!buildDatabase(directory / "dataset.db", DATASET_SCHEMA_PATH, DATASET_ROWS) ||
+        !buildDatabase(directory / "user.db", USER_SCHEMA_PATH, USER_ROWS)) {
+        return EXIT_FAILURE;
+    }
+
+#ifdef _WIN32
+    _putenv_s(QueryPlanAuditor::ENVIRONMENT_VARIABLE, "1");
+#else
+    setenv(QueryPlanAuditor::ENVIRONMENT_VARIABLE, "1", 1);
+#endif
+
+    int failures = 0;
+    {
+        Database database((directory / "user.db").string());
+        database.initialize();
+
+        QueryPlanAuditor* auditor = database.queryAuditor();
+        if (!auditor) {
+            std::cerr << "Query auditing could not be enabled." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        for (const auto& call : repositoryCalls(database)) {
+            auditor->clear();
+            call.run();
+
+            const auto entries = auditor->report();
+            if (entries.empty()) {
+                std::cerr << call.name << ": no statement was recorded" << std::endl;
+                failures++;
+            }
+
+            for (const auto& entry : entries) {
+                for (const auto& scan : entry.fullScans) {
+                    if (scan.table == call.expectedScan) {
+                        continue;
+                    }
+                    std::cerr << call.name << ": full scan of " << scan.table << " (" << scan.detail
+                              << ") in: " << entry.sql << std::endl;
+                    failures++;
+                }
+            }
+        }
+        auditor->clear();
+    }
+
+    fs::remove_all(directory, error);
+
+    if (failures > 0) {
+        std::cerr << failures << " query plan problem(s) found" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "No repository query scans a large table" << std::endl;
+    return EXIT_SUCCESS;
+}